@@ -0,0 +1,34 @@
+#include "alloc_counter.hpp"
+
+static thread_local long long threadAllocations = 0;
+
+long long allocationCount()
+{
+    return threadAllocations;
+}
+
+void* operator new(size_t size)
+{
+    threadAllocations++;
+    void* memory = malloc(size ? size : 1);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+// GCC sees free() inlined against operator new and warns; both sides are malloc here
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,14 @@
+#ifndef ALLOC_COUNTER_HPP
+#define ALLOC_COUNTER_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global operator new with one that counts allocations per thread,
+// so --check-alloc can prove the simulated turn loop never touches the heap.
+long long allocationCount();
+
+#endif // ALLOC_COUNTER_HPP
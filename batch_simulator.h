@@ -0,0 +1,361 @@
+#include "batch_simulator.hpp"
+
+struct BatchWorkerParams {
+    const BatchConfig* config;
+    long long firstGame;
+    long long lastGame;
+    BatchResult result;
+    CellHeatmap* heatmap;       // this worker's own counters, or nullptr
+};
+
+template <class Rules>
+void* batchWorker(void* arg)
+{
+    BatchWorkerParams* params = static_cast<BatchWorkerParams*>(arg);
+    const BatchConfig& config = *params->config;
+
+    // One engine per worker, reset between games
+    LudoEngine<Rules> engine;
+    for (long long game = params->firstGame; game < params->lastGame; ++game) {
+        engine.reset(config.rules.numPlayers, static_cast<uint32_t>(config.seed + game));
+        if (params->heatmap) {
+            CellHeatmap& heatmap = *params->heatmap;
+            params->result.totalTurns += engine.playObservedGame(config.maxTurns, [&](int player, const MoveResult& result) {
+                recordMove(heatmap, engine, player, result);
+            });
+            heatmap.games++;
+        } else {
+            params->result.totalTurns += engine.playRandomGame(config.maxTurns);
+        }
+
+        const GameState& state = engine.state();
+        if (!engine.gameIsOver()) {
+            params->result.unfinished++;
+        } else if (state.finishedPlayers > 0) {
+            params->result.wins[state.finishingOrder[0]]++;
+        }
+        for (int player = 0; player < state.numPlayers; ++player) {
+            params->result.eliminations[player] += state.eliminated[player];
+        }
+        params->result.games++;
+    }
+
+    return nullptr;
+}
+
+BatchResult runBatch(const BatchConfig& config, CellHeatmap* heatmap)
+{
+    long long firstGame = config.firstGame;
+    long long gameCount = (config.lastGame < 0 ? config.games : config.lastGame) - firstGame;
+
+    int threadCount = workerThreadCount(config.threads);
+    if (threadCount > gameCount) {
+        threadCount = static_cast<int>(max(1LL, gameCount));
+    }
+
+    void* (*worker)(void*) = nullptr;
+    dispatchRules(config.rules, [&](auto rules) {
+        worker = &batchWorker<decltype(rules)>;
+    });
+
+    vector<pthread_t> threads(threadCount);
+    vector<BatchWorkerParams> params(threadCount);
+    vector<CellHeatmap> heatmaps(heatmap ? threadCount : 0);
+    auto start = chrono::steady_clock::now();
+
+    for (int i = 0; i < threadCount; ++i) {
+        params[i].config = &config;
+        params[i].firstGame = firstGame + gameCount * i / threadCount;
+        params[i].lastGame = firstGame + gameCount * (i + 1) / threadCount;
+        params[i].heatmap = heatmap ? &heatmaps[i] : nullptr;
+        pthread_create(&threads[i], nullptr, worker, &params[i]);
+    }
+
+    BatchResult total;
+    for (int i = 0; i < threadCount; ++i) {
+        pthread_join(threads[i], nullptr);
+        total.games += params[i].result.games;
+        total.unfinished += params[i].result.unfinished;
+        total.totalTurns += params[i].result.totalTurns;
+        for (int player = 0; player < LudoBoard::MAX_PLAYERS; ++player) {
+            total.wins[player] += params[i].result.wins[player];
+            total.eliminations[player] += params[i].result.eliminations[player];
+        }
+        if (heatmap) {
+            heatmap->merge(heatmaps[i]);
+        }
+    }
+
+    total.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return total;
+}
+
+int workerThreadCount(int requested)
+{
+    return requested > 0 ? requested : static_cast<int>(max(1u, thread::hardware_concurrency()));
+}
+
+void runWorkQueue(int threads, void* (*worker)(void*), WorkQueue& queue)
+{
+    int threadCount = static_cast<int>(min<size_t>(workerThreadCount(threads), max<size_t>(queue.count, 1)));
+    vector<pthread_t> handles(threadCount);
+    for (int i = 0; i < threadCount; ++i) {
+        pthread_create(&handles[i], nullptr, worker, &queue);
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        pthread_join(handles[i], nullptr);
+    }
+}
+
+void printBatchResult(const BatchConfig& config, const BatchResult& result)
+{
+    cout << "Games: " << result.games << " (" << result.unfinished << " unfinished)" << endl;
+    for (int player = 0; player < config.rules.numPlayers; ++player) {
+        cout << "Player " << player + 1 << " wins: " << result.wins[player]
+             << " | eliminated: " << result.eliminations[player] << endl;
+    }
+    if (result.seconds > 0) {
+        cout << "Moves: " << result.totalTurns << " in " << result.seconds << " s ("
+             << static_cast<long long>(result.totalTurns / result.seconds) << " moves/s)" << endl;
+    } else {
+        cout << "Moves: " << result.totalTurns << endl;
+    }
+}
+
+void saveBatchResult(const string& path, const BatchConfig& config, const BatchResult& result)
+{
+    ofstream out(path);
+    if (!out) {
+        throw runtime_error("Cannot write " + path);
+    }
+
+    long long lastGame = config.lastGame < 0 ? config.games : config.lastGame;
+    out << "# ludo batch result v1\n"
+        << "players " << config.rules.numPlayers << "\n"
+        << "team " << config.rules.teamMode << "\n"
+        << "killer " << config.rules.killerRule << "\n"
+        << "blockades " << config.rules.blockades << "\n"
+        << "elimination " << config.rules.inactivityElimination << "\n"
+        << "seed " << config.seed << "\n"
+        << "max-turns " << config.maxTurns << "\n"
+        << "range " << config.firstGame << " " << lastGame << "\n"
+        << "games " << result.games << "\n"
+        << "unfinished " << result.unfinished << "\n"
+        << "turns " << result.totalTurns << "\n";
+    out << "wins";
+    for (long long wins : result.wins) {
+        out << " " << wins;
+    }
+    out << "\neliminations";
+    for (long long eliminations : result.eliminations) {
+        out << " " << eliminations;
+    }
+    out << "\n";
+}
+
+struct BatchShard {
+    string path;
+    BatchConfig config;
+    BatchResult result;
+};
+
+static BatchShard loadBatchResult(const string& path)
+{
+    ifstream in(path);
+    string line;
+    if (!in || !getline(in, line) || line != "# ludo batch result v1") {
+        throw runtime_error(path + " is not a batch result file");
+    }
+
+    BatchShard shard;
+    shard.path = path;
+    BatchConfig& config = shard.config;
+    BatchResult& result = shard.result;
+    int fields = 0;
+
+    while (getline(in, line)) {
+        istringstream values(line);
+        string key;
+        values >> key;
+
+        if (key == "players") values >> config.rules.numPlayers;
+        else if (key == "team") values >> config.rules.teamMode;
+        else if (key == "killer") values >> config.rules.killerRule;
+        else if (key == "blockades") values >> config.rules.blockades;
+        else if (key == "elimination") values >> config.rules.inactivityElimination;
+        else if (key == "seed") values >> config.seed;
+        else if (key == "max-turns") values >> config.maxTurns;
+        else if (key == "range") values >> config.firstGame >> config.lastGame;
+        else if (key == "games") values >> result.games;
+        else if (key == "unfinished") values >> result.unfinished;
+        else if (key == "turns") values >> result.totalTurns;
+        else if (key == "wins") for (long long& wins : result.wins) values >> wins;
+        else if (key == "eliminations") for (long long& eliminations : result.eliminations) values >> eliminations;
+        else continue;
+
+        if (!values) {
+            throw runtime_error("Bad line in " + path + ": " + line);
+        }
+        fields++;
+    }
+
+    if (fields != 13) {
+        throw runtime_error(path + " is incomplete");
+    }
+    config.games = config.lastGame;
+    return shard;
+}
+
+BatchResult mergeBatchResults(const vector<string>& paths, BatchConfig& config)
+{
+    if (paths.empty()) {
+        throw runtime_error("Nothing to merge.");
+    }
+
+    vector<BatchShard> shards;
+    for (const string& path : paths) {
+        shards.push_back(loadBatchResult(path));
+    }
+    sort(shards.begin(), shards.end(), [](const BatchShard& a, const BatchShard& b) {
+        return a.config.firstGame < b.config.firstGame;
+    });
+
+    const BatchConfig& first = shards[0].config;
+    BatchResult total;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        const BatchConfig& shard = shards[i].config;
+        if (shard.rules.numPlayers != first.rules.numPlayers || shard.rules.teamMode != first.rules.teamMode ||
+            shard.rules.killerRule != first.rules.killerRule || shard.rules.blockades != first.rules.blockades ||
+            shard.rules.inactivityElimination != first.rules.inactivityElimination ||
+            shard.seed != first.seed || shard.maxTurns != first.maxTurns) {
+            throw runtime_error(shards[i].path + " comes from a different experiment than " + shards[0].path);
+        }
+        if (i > 0 && shard.firstGame != shards[i - 1].config.lastGame) {
+            throw runtime_error(string(shard.firstGame < shards[i - 1].config.lastGame ? "Overlapping" : "Missing") +
+                                " games between " + shards[i - 1].path + " and " + shards[i].path);
+        }
+
+        const BatchResult& result = shards[i].result;
+        total.games += result.games;
+        total.unfinished += result.unfinished;
+        total.totalTurns += result.totalTurns;
+        for (int player = 0; player < LudoBoard::MAX_PLAYERS; ++player) {
+            total.wins[player] += result.wins[player];
+            total.eliminations[player] += result.eliminations[player];
+        }
+    }
+
+    config = first;
+    config.lastGame = shards.back().config.lastGame;
+    config.games = config.lastGame;
+    return total;
+}
+
+int checkAllocations(const BatchConfig& config)
+{
+    int failures = 0;
+
+    for (int variant = 0; variant < 32; ++variant) {
+        RulesConfig rulesConfig;
+        rulesConfig.teamMode = variant & 1;
+        rulesConfig.numPlayers = rulesConfig.teamMode ? 4 : config.rules.numPlayers;
+        rulesConfig.killerRule = variant & 2;
+        rulesConfig.blockades = variant & 4;
+        rulesConfig.teammatePassing = variant & 8;
+        rulesConfig.inactivityElimination = variant & 16;
+
+        dispatchRules(rulesConfig, [&](auto rules) {
+            LudoEngine<decltype(rules)> engine;
+            for (long long game = 0; game < config.games; ++game) {
+                engine.reset(rulesConfig.numPlayers, static_cast<uint32_t>(config.seed + game));
+
+                long long before = allocationCount();
+                engine.playRandomGame(config.maxTurns);
+                long long allocations = allocationCount() - before;
+
+                if (allocations != 0) {
+                    cout << "Variant " << variant << " game " << game << ": " << allocations << " allocations" << endl;
+                    failures++;
+                }
+            }
+        });
+    }
+
+    cout << (failures == 0 ? "No allocations in the turn loop." : "Turn loop allocated.") << endl;
+    return failures;
+}
+
+BatchConfig parseBatchOptions(int argc, char* argv[], int first)
+{
+    BatchConfig config;
+    int shardIndex = 0;
+    int shardCount = 0;
+
+    for (int i = first; i < argc; ++i) {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (option == "--players" && hasValue) {
+            config.rules.numPlayers = stoi(argv[++i]);
+        } else if (option == "--team") {
+            config.rules.teamMode = true;
+            config.rules.numPlayers = 4;
+        } else if (option == "--no-killer") {
+            config.rules.killerRule = false;
+        } else if (option == "--no-blockades") {
+            config.rules.blockades = false;
+        } else if (option == "--no-elimination") {
+            config.rules.inactivityElimination = false;
+        } else if (option == "--games" && hasValue) {
+            config.games = stoll(argv[++i]);
+        } else if (option == "--seed" && hasValue) {
+            config.seed = stoull(argv[++i]);
+        } else if (option == "--threads" && hasValue) {
+            config.threads = stoi(argv[++i]);
+        } else if (option == "--max-turns" && hasValue) {
+            config.maxTurns = stoi(argv[++i]);
+        } else if (option == "--delay" && hasValue) {
+            config.frameDelayMs = stoi(argv[++i]);
+        } else if (option == "--heatmap" && hasValue) {
+            config.heatmapPath = argv[++i];
+        } else if (option == "--publish" && hasValue) {
+            config.publishName = argv[++i];
+        } else if (option == "--shard" && hasValue) {
+            string spec = argv[++i];
+            size_t slash = spec.find('/');
+            if (slash == string::npos) {
+                throw runtime_error("Shard must be K/N: " + spec);
+            }
+            shardIndex = stoi(spec.substr(0, slash));
+            shardCount = stoi(spec.substr(slash + 1));
+        } else if (option == "--range" && hasValue) {
+            string spec = argv[++i];
+            size_t colon = spec.find(':');
+            if (colon == string::npos) {
+                throw runtime_error("Range must be FIRST:LAST: " + spec);
+            }
+            config.firstGame = stoll(spec.substr(0, colon));
+            config.lastGame = stoll(spec.substr(colon + 1));
+        } else if (option == "--out" && hasValue) {
+            config.resultPath = argv[++i];
+        } else {
+            throw runtime_error("Unknown option: " + option);
+        }
+    }
+
+    if (config.rules.numPlayers < 2 || config.rules.numPlayers > LudoBoard::MAX_PLAYERS) {
+        throw runtime_error("Number of players must be between 2 and 4.");
+    }
+    if (shardCount > 0) {
+        if (shardIndex < 0 || shardIndex >= shardCount) {
+            throw runtime_error("Shard index must be between 0 and N-1.");
+        }
+        config.firstGame = config.games * shardIndex / shardCount;
+        config.lastGame = config.games * (shardIndex + 1) / shardCount;
+    }
+    if (config.firstGame < 0 || (config.lastGame >= 0 && config.lastGame < config.firstGame)) {
+        throw runtime_error("Game range must satisfy 0 <= FIRST <= LAST.");
+    }
+
+    return config;
+}
@@ -0,0 +1,89 @@
+#ifndef BATCH_SIMULATOR_HPP
+#define BATCH_SIMULATOR_HPP
+
+#pragma once
+
+#include <pthread.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <chrono>
+#include <thread>
+#include "ludo_engine.hpp"
+#include "alloc_counter.hpp"
+#include "cell_heatmap.hpp"
+
+using namespace std;
+
+struct BatchConfig {
+    RulesConfig rules;
+    long long games = 1000;
+    long long firstGame = 0;    // game-id range [firstGame, lastGame) this process plays
+    long long lastGame = -1;    // -1 = games
+    uint64_t seed = 1;
+    int threads = 0;            // 0 = one per hardware thread
+    int maxTurns = 10000;       // games still running after this many moves count as unfinished
+    int frameDelayMs = 100;     // --watch only
+    string heatmapPath;         // --batch only; empty = no heatmap
+    string publishName;         // --watch only; shared-memory name, empty = not published
+    string resultPath;          // --batch and --merge; empty = print only
+};
+
+struct BatchResult {
+    long long games = 0;
+    long long unfinished = 0;
+    long long totalTurns = 0;
+    long long wins[LudoBoard::MAX_PLAYERS] = {};
+    long long eliminations[LudoBoard::MAX_PLAYERS] = {};
+    double seconds = 0;
+};
+
+// Plays games [firstGame, lastGame) random games headless on all cores. Game g always
+// uses seed config.seed + g, so results do not depend on the thread count or on how
+// the range is split across processes. A non-null heatmap receives per-cell
+// landings, captures and blockades from every game.
+BatchResult runBatch(const BatchConfig& config, CellHeatmap* heatmap = nullptr);
+void printBatchResult(const BatchConfig& config, const BatchResult& result);
+
+// Self-describing text result: rules, seed, turn limit, game-id range and totals.
+// Timing is left out so equal inputs always give byte-identical files.
+void saveBatchResult(const string& path, const BatchConfig& config, const BatchResult& result);
+
+// Combines shard files of one experiment. The shards must share rules, seed and turn
+// limit and cover a contiguous game-id range without overlaps; the merged file is
+// byte-identical to the one a single run over that range writes.
+BatchResult mergeBatchResults(const vector<string>& paths, BatchConfig& config);
+
+// Items [0, count) shared by a pool of worker threads. Each worker loops on claim()
+// and keeps its per-thread state (engine, buffers) in locals.
+struct WorkQueue {
+    void* context;              // the caller's shared parameters
+    size_t count;
+    atomic<size_t> next{0};
+
+    bool claim(size_t& index) { index = next++; return index < count; }
+};
+
+// Threads to use for a requested count, 0 meaning one per hardware thread
+int workerThreadCount(int requested);
+
+// Runs worker(&queue) on workerThreadCount(threads) threads, never more than there
+// are items, and returns once they have all finished
+void runWorkQueue(int threads, void* (*worker)(void*), WorkQueue& queue);
+
+// Plays config.games games under every rule variant and counts the heap allocations
+// made inside the turn loop. Returns the number of games that allocated.
+int checkAllocations(const BatchConfig& config);
+
+// Parses "--players N --team --no-killer --no-blockades --no-elimination --seed S
+// --threads T --max-turns M --games G --delay MS --heatmap PATH --publish NAME
+// --shard K/N --range FIRST:LAST --out PATH" starting at argv[first]. --shard K/N
+// plays the K-th (0-based) of N equal slices of games 0..G.
+BatchConfig parseBatchOptions(int argc, char* argv[], int first);
+
+#endif // BATCH_SIMULATOR_HPP
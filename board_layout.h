@@ -0,0 +1,79 @@
+#include "board_layout.hpp"
+
+sf::Color cellColor(CellKind kind)
+{
+    static const sf::Color colors[] = {
+        sf::Color::White,           // CELL_WHITE
+        sf::Color::Red,             // CELL_RED
+        sf::Color::Green,           // CELL_GREEN
+        sf::Color::Blue,            // CELL_BLUE
+        sf::Color::Yellow,          // CELL_YELLOW
+        sf::Color::Black,           // CELL_BLACK
+        sf::Color(128, 128, 128)    // CELL_GREY
+    };
+    return colors[kind];
+}
+
+sf::Color playerColor(int player)
+{
+    return cellColor(LudoBoard::playerCellKind(player));
+}
+
+sf::Color boardPixel(int x, int y, int tile)
+{
+    // The last column and row have no neighbour drawn after them, so they keep their fill
+    if ((x % tile == tile - 1 && x / tile < LudoBoard::BOARD_SIZE - 1) ||
+        (y % tile == tile - 1 && y / tile < LudoBoard::BOARD_SIZE - 1)) {
+        return sf::Color::Black;
+    }
+    return cellColor(LudoBoard::cellKind(y / tile, x / tile));
+}
+
+float starRadius(float tile)
+{
+    return tile / 6.f;
+}
+
+sf::Vector2f starPoint(float tile, int point)
+{
+    float angle = point * 36 * 3.14159f / 180;
+    float r = (point % 2 == 0) ? starRadius(tile) : starRadius(tile) / 2.5f;
+    return sf::Vector2f(r * cos(angle), r * sin(angle));
+}
+
+void layoutTokens(const GameState& state, float tile, TokenSprite sprites[LudoBoard::MAX_PLAYERS][LudoBoard::MAX_TOKENS_PER_PLAYER])
+{
+    // Count tokens at each position
+    int tokenCount[LudoBoard::CELL_COUNT] = {};
+    for (int player = 0; player < state.numPlayers; ++player) {
+        for (int i = 0; i < LudoBoard::MAX_TOKENS_PER_PLAYER; ++i) {
+            if (!state.finished[player][i]) {
+                tokenCount[state.tokens[player][i]]++;
+            }
+        }
+    }
+
+    for (int player = 0; player < LudoBoard::MAX_PLAYERS; ++player) {
+        for (int i = 0; i < LudoBoard::MAX_TOKENS_PER_PLAYER; ++i) {
+            TokenSprite& sprite = sprites[player][i];
+            uint8_t cell = state.tokens[player][i];
+            sprite.visible = player < state.numPlayers && !state.finished[player][i];
+            if (!sprite.visible) continue;
+
+            // Smaller tokens, nudged apart, when several share a cell
+            int count = tokenCount[cell];
+            sprite.radius = (count > 1) ? tile / (3.f + count) : tile / 3.f;
+            sprite.starScale = count > 1 ? 0.5f : 1.f;
+
+            float offset = (count > 1) ? tile / 8.f : 0.f;
+            float angleOffset = (count > 1) ? (i * 2 * 3.14159f / count) : 0.f;
+            float xOffset = offset * cos(angleOffset) + (i % 2 == 0 ? -offset : offset);
+            float yOffset = offset * sin(angleOffset) + (i % 2 == 0 ? -offset : offset);
+
+            sprite.left = LudoBoard::column(cell) * tile + tile / 6.f + xOffset;
+            sprite.top = LudoBoard::row(cell) * tile + tile / 6.f + yOffset;
+            sprite.starX = sprite.left + sprite.radius - starRadius(tile) / 4.f;
+            sprite.starY = sprite.top + sprite.radius - starRadius(tile) / 4.f;
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef BOARD_LAYOUT_HPP
+#define BOARD_LAYOUT_HPP
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include "ludo_engine.hpp"
+
+using namespace std;
+
+// Colours and token geometry shared by every board renderer, so the GUI, the mosaic
+// and offscreen exports draw the same picture
+sf::Color cellColor(CellKind kind);
+sf::Color playerColor(int player);
+
+// Pixel (x, y) of the board as drawBoard leaves it: cell colours with the one-pixel
+// outline each cell draws over the last row and column of its upper and left neighbours
+sf::Color boardPixel(int x, int y, int tile);
+
+// Where renderGame puts one token on a board of tile-pixel cells
+struct TokenSprite {
+    bool visible;               // finished tokens and empty seats are not drawn
+    float left;                 // top-left of the token circle's bounding box
+    float top;
+    float radius;
+    float starX;                // centre of the star drawn on the token
+    float starY;
+    float starScale;            // 1, or 0.5 on a stack
+};
+
+// Lays out every seated token, spreading stacked tokens around their cell
+void layoutTokens(const GameState& state, float tile, TokenSprite sprites[LudoBoard::MAX_PLAYERS][LudoBoard::MAX_TOKENS_PER_PLAYER]);
+
+// Outer radius and the ten points of the token star, around (0, 0), for a tile-pixel board
+float starRadius(float tile);
+sf::Vector2f starPoint(float tile, int point);
+
+#endif // BOARD_LAYOUT_HPP
@@ -0,0 +1,113 @@
+#include "cell_heatmap.hpp"
+
+void CellHeatmap::merge(const CellHeatmap& other)
+{
+    games += other.games;
+    for (int layer = 0; layer < HEAT_LAYERS; ++layer) {
+        for (int cell = 0; cell < LudoBoard::CELL_COUNT; ++cell) {
+            counts[layer][cell] += other.counts[layer][cell];
+        }
+    }
+}
+
+uint64_t CellHeatmap::maxCount(int layer) const
+{
+    return *max_element(counts[layer], counts[layer] + LudoBoard::CELL_COUNT);
+}
+
+const char* CellHeatmap::layerName(int layer)
+{
+    static const char* const names[HEAT_LAYERS] = {"landings", "captures", "blockades"};
+    return names[layer];
+}
+
+template <class Rules>
+void recordMove(CellHeatmap& heatmap, const LudoEngine<Rules>& engine, int player, const MoveResult& result)
+{
+    if (result.to == result.from) {
+        return;
+    }
+
+    heatmap.counts[HEAT_LANDINGS][result.to]++;
+    heatmap.counts[HEAT_CAPTURES][result.to] += __builtin_popcount(result.capturedTokens);
+    if (Rules::Blockade::enabled && !engine.isSafeZone(result.to) && engine.tokenCountAt(player, result.to) >= 2) {
+        heatmap.counts[HEAT_BLOCKADES][result.to]++;
+    }
+}
+
+void saveHeatmap(const string& path, const CellHeatmap& heatmap)
+{
+    ofstream out(path);
+    if (!out) {
+        throw runtime_error("Cannot write " + path);
+    }
+
+    const LudoBoard& board = LudoBoard::get();
+    out << "# games " << heatmap.games << "\n";
+    out << "row,column,safe";
+    for (int layer = 0; layer < HEAT_LAYERS; ++layer) {
+        out << "," << CellHeatmap::layerName(layer);
+    }
+    out << "\n";
+
+    for (int cell = 0; cell < LudoBoard::CELL_COUNT; ++cell) {
+        out << LudoBoard::row(cell) << "," << LudoBoard::column(cell) << "," << int(board.safeZone[cell]);
+        for (int layer = 0; layer < HEAT_LAYERS; ++layer) {
+            out << "," << heatmap.counts[layer][cell];
+        }
+        out << "\n";
+    }
+}
+
+CellHeatmap loadHeatmap(const string& path)
+{
+    ifstream in(path);
+    if (!in) {
+        throw runtime_error("Cannot read " + path);
+    }
+
+    CellHeatmap heatmap;
+    string line;
+    while (getline(in, line)) {
+        if (line.compare(0, 8, "# games ") == 0) {
+            heatmap.games = stoll(line.substr(8));
+            continue;
+        }
+        if (line.empty() || !isdigit(static_cast<unsigned char>(line[0]))) continue;
+
+        replace(line.begin(), line.end(), ',', ' ');
+        istringstream fields(line);
+        int row, column, safe;
+        fields >> row >> column >> safe;
+        if (!fields || row < 0 || row >= LudoBoard::BOARD_SIZE || column < 0 || column >= LudoBoard::BOARD_SIZE) {
+            throw runtime_error("Bad heatmap row in " + path + ": " + line);
+        }
+        for (int layer = 0; layer < HEAT_LAYERS; ++layer) {
+            fields >> heatmap.counts[layer][LudoBoard::cell(row, column)];
+        }
+    }
+    return heatmap;
+}
+
+void printHeatmapSummary(const CellHeatmap& heatmap, int topCells)
+{
+    const LudoBoard& board = LudoBoard::get();
+    int cells[LudoBoard::CELL_COUNT];
+    for (int cell = 0; cell < LudoBoard::CELL_COUNT; ++cell) {
+        cells[cell] = cell;
+    }
+    topCells = min(topCells, static_cast<int>(LudoBoard::CELL_COUNT));
+    partial_sort(cells, cells + topCells, cells + LudoBoard::CELL_COUNT, [&](int a, int b) {
+        return heatmap.counts[HEAT_CAPTURES][a] > heatmap.counts[HEAT_CAPTURES][b];
+    });
+
+    cout << "Most dangerous cells (captures per game):" << endl;
+    for (int i = 0; i < topCells && heatmap.counts[HEAT_CAPTURES][cells[i]] > 0; ++i) {
+        int cell = cells[i];
+        cout << "  (" << LudoBoard::row(cell) << ", " << LudoBoard::column(cell) << ")"
+             << (board.safeZone[cell] ? " safe" : "")
+             << ": " << static_cast<double>(heatmap.counts[HEAT_CAPTURES][cell]) / max(1LL, heatmap.games)
+             << " | landings " << static_cast<double>(heatmap.counts[HEAT_LANDINGS][cell]) / max(1LL, heatmap.games)
+             << " | blockades " << static_cast<double>(heatmap.counts[HEAT_BLOCKADES][cell]) / max(1LL, heatmap.games) << endl;
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef CELL_HEATMAP_HPP
+#define CELL_HEATMAP_HPP
+
+#pragma once
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "ludo_engine.hpp"
+
+using namespace std;
+
+enum HeatmapLayer {
+    HEAT_LANDINGS,
+    HEAT_CAPTURES,              // tokens sent back to the yard from the cell
+    HEAT_BLOCKADES,             // a move stacked two or more tokens on an unsafe cell
+    HEAT_LAYERS
+};
+
+// Per-cell event counts aggregated over simulated games. Batch workers each fill
+// their own copy and runBatch merges them after the join.
+struct CellHeatmap {
+    long long games = 0;
+    uint64_t counts[HEAT_LAYERS][LudoBoard::CELL_COUNT] = {};
+
+    void merge(const CellHeatmap& other);
+    uint64_t maxCount(int layer) const;
+    static const char* layerName(int layer);
+};
+
+template <class Rules>
+void recordMove(CellHeatmap& heatmap, const LudoEngine<Rules>& engine, int player, const MoveResult& result);
+
+// CSV with one row per cell: row, column, safe zone flag and the three layers
+void saveHeatmap(const string& path, const CellHeatmap& heatmap);
+CellHeatmap loadHeatmap(const string& path);
+
+// The cells with the most captures, for the safe-zone layout discussion
+void printHeatmapSummary(const CellHeatmap& heatmap, int topCells = 10);
+
+#endif // CELL_HEATMAP_HPP
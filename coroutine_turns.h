@@ -0,0 +1,159 @@
+#include "coroutine_turns.hpp"
+
+TurnTask::~TurnTask()
+{
+    if (handle) {
+        handle.destroy();
+    }
+}
+
+void TurnTask::rethrow() const
+{
+    if (handle.promise().exception) {
+        rethrow_exception(handle.promise().exception);
+    }
+}
+
+void TimerAwaiter::await_suspend(coroutine_handle<> handle)
+{
+    waiting = handle;
+    if (ticks == 0) {
+        executor->post(handle);
+        return;
+    }
+
+    node.callback = &TimerAwaiter::fire;
+    node.context = this;
+    executor->schedule(&node, ticks);
+}
+
+void TimerAwaiter::fire(TimerNode*, void* context)
+{
+    TimerAwaiter* awaiter = static_cast<TimerAwaiter*>(context);
+    awaiter->executor->post(awaiter->waiting);
+}
+
+TurnExecutor::TurnExecutor(chrono::microseconds tick)
+    : tickLength(tick),
+      start(chrono::steady_clock::now()),
+      resumeCount(0),
+      maxWaiting(0)
+{
+}
+
+void TurnExecutor::post(coroutine_handle<> handle)
+{
+    ready.push_back(handle);
+}
+
+uint64_t TurnExecutor::elapsedTicks() const
+{
+    return (chrono::steady_clock::now() - start) / tickLength;
+}
+
+void TurnExecutor::run()
+{
+    while (!ready.empty() || timers.scheduledCount() > 0) {
+        // Resume this round's ready games; anything they post waits for the next round
+        running.swap(ready);
+        for (coroutine_handle<> handle : running) {
+            handle.resume();
+            resumeCount++;
+        }
+        running.clear();
+
+        maxWaiting = max(maxWaiting, timers.scheduledCount());
+        if (ready.empty() && timers.scheduledCount() > 0) {
+            // Every game is waiting on an agent
+            this_thread::sleep_for(tickLength);
+        }
+        timers.advance(elapsedTicks());
+    }
+}
+
+template <class Rules>
+TurnTask coroutineGame(TurnExecutor& executor, const CoroutineConfig& config, long long game,
+                       mt19937& latency, BatchResult& result)
+{
+    const BatchConfig& batch = config.batch;
+    uniform_int_distribution<int> agentTicks(0, 2 * config.agentMs);
+
+    LudoEngine<Rules> engine;
+    engine.reset(batch.rules.numPlayers, static_cast<uint32_t>(batch.seed + game));
+    GameState& state = engine.state();
+
+    // Same sequence as playRandomGame, with a wait for the agent before every roll and move
+    while (state.turn < batch.maxTurns && !engine.gameIsOver()) {
+        int player = state.currentPlayer;
+        if (engine.shouldSkipTurn(player)) {
+            engine.advanceTurn();
+            continue;
+        }
+
+        co_await executor.wait(agentTicks(latency));
+        engine.rollDice();
+        co_await executor.wait(agentTicks(latency));
+        engine.moveToken(player, engine.pickRandomToken(player, engine.randomEngine()));
+    }
+
+    result.totalTurns += state.turn;
+    if (!engine.gameIsOver()) {
+        result.unfinished++;
+    } else if (state.finishedPlayers > 0) {
+        result.wins[state.finishingOrder[0]]++;
+    }
+    for (int player = 0; player < state.numPlayers; ++player) {
+        result.eliminations[player] += state.eliminated[player];
+    }
+    result.games++;
+}
+
+BatchResult runCoroutineGames(const CoroutineConfig& config, TurnExecutor& executor)
+{
+    const BatchConfig& batch = config.batch;
+    long long lastGame = batch.lastGame < 0 ? batch.games : batch.lastGame;
+
+    BatchResult result;
+    mt19937 latency(static_cast<uint32_t>(batch.seed));
+    vector<TurnTask> games;
+    games.reserve(lastGame - batch.firstGame);
+
+    dispatchRules(batch.rules, [&](auto rules) {
+        for (long long game = batch.firstGame; game < lastGame; ++game) {
+            games.push_back(coroutineGame<decltype(rules)>(executor, config, game, latency, result));
+            executor.post(games.back().coroutine());
+        }
+    });
+
+    auto start = chrono::steady_clock::now();
+    executor.run();
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    for (const TurnTask& game : games) {
+        game.rethrow();
+    }
+    return result;
+}
+
+CoroutineConfig parseCoroutineOptions(int argc, char* argv[], int first)
+{
+    CoroutineConfig config;
+    vector<char*> batchOptions;
+
+    for (int i = first; i < argc; ++i) {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (option == "--agent-ms" && hasValue) {
+            config.agentMs = stoi(argv[++i]);
+        } else {
+            batchOptions.push_back(argv[i]);
+        }
+    }
+
+    config.batch = parseBatchOptions(static_cast<int>(batchOptions.size()), batchOptions.data(), 0);
+    if (config.agentMs < 0) {
+        throw runtime_error("Agent latency must not be negative.");
+    }
+    return config;
+}
@@ -0,0 +1,107 @@
+#ifndef COROUTINE_TURNS_HPP
+#define COROUTINE_TURNS_HPP
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "ludo_engine.hpp"
+#include "timer_wheel.hpp"
+#include "batch_simulator.hpp"
+
+using namespace std;
+
+// One game's turn flow as a coroutine. It starts suspended and is resumed only by a
+// TurnExecutor; the task owns the frame and destroys it.
+class TurnTask {
+public:
+    struct promise_type {
+        exception_ptr exception;
+
+        TurnTask get_return_object() { return TurnTask(coroutine_handle<promise_type>::from_promise(*this)); }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { exception = current_exception(); }
+    };
+
+    TurnTask(TurnTask&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    ~TurnTask();
+
+    coroutine_handle<> coroutine() const { return handle; }
+    bool done() const { return handle.done(); }
+    void rethrow() const;       // rethrows anything the game let escape
+
+private:
+    coroutine_handle<promise_type> handle;
+
+    explicit TurnTask(coroutine_handle<promise_type> handle) : handle(handle) {}
+    TurnTask(const TurnTask&) = delete;
+    TurnTask& operator=(const TurnTask&) = delete;
+};
+
+class TurnExecutor;
+
+// co_await executor.wait(ticks): parks the coroutine on the executor's timer wheel.
+// The timer node lives in the awaiting frame, so waiting never allocates. A zero wait
+// still yields so other ready games run first.
+struct TimerAwaiter {
+    TurnExecutor* executor;
+    uint64_t ticks;
+    TimerNode node;
+    coroutine_handle<> waiting;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(coroutine_handle<> handle);
+    void await_resume() const noexcept {}
+
+    static void fire(TimerNode* node, void* context);
+};
+
+// Single-threaded scheduler: a FIFO of coroutines ready to resume plus a timer wheel of
+// coroutines waiting on an agent. Nothing blocks per game; the thread sleeps only when
+// every game is waiting.
+class TurnExecutor {
+public:
+    explicit TurnExecutor(chrono::microseconds tick = chrono::milliseconds(1));
+
+    void post(coroutine_handle<> handle);
+    TimerAwaiter wait(uint64_t ticks) { return TimerAwaiter{this, ticks, TimerNode(), nullptr}; }
+    void schedule(TimerNode* node, uint64_t ticks) { timers.schedule(node, ticks); }
+
+    // Runs until no coroutine is ready or waiting
+    void run();
+
+    long long resumes() const { return resumeCount; }
+    int peakWaiting() const { return maxWaiting; }
+
+private:
+    TimerWheel timers;
+    vector<coroutine_handle<>> ready;
+    vector<coroutine_handle<>> running;
+    chrono::microseconds tickLength;
+    chrono::steady_clock::time_point start;
+    long long resumeCount;
+    int maxWaiting;
+
+    uint64_t elapsedTicks() const;
+};
+
+struct CoroutineConfig {
+    BatchConfig batch;          // rules, games, seed, max turns
+    int agentMs = 1;            // mean agent response time per roll and per move
+};
+
+// Plays config.batch games interleaved on the calling thread. Each roll and move waits
+// for an agent that answers after 0..2*agentMs ms. Game g plays exactly the moves
+// --batch plays for it, so the totals match runBatch whatever the latencies.
+BatchResult runCoroutineGames(const CoroutineConfig& config, TurnExecutor& executor);
+
+// "--agent-ms N" plus the batch options
+CoroutineConfig parseCoroutineOptions(int argc, char* argv[], int first);
+
+#endif // COROUTINE_TURNS_HPP
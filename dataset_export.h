@@ -0,0 +1,381 @@
+#include "dataset_export.hpp"
+
+static const char DATASET_MAGIC[8] = {'L', 'U', 'D', 'O', 'C', 'O', 'L', '1'};
+static const uint32_t DATASET_VERSION = 1;
+
+struct DatasetField {
+    const char* name;
+    size_t offset;
+    uint32_t width;
+};
+
+static const DatasetField DATASET_FIELDS[] = {
+    {"game", offsetof(DecisionRow, game), 4},
+    {"turn", offsetof(DecisionRow, turn), 4},
+    {"player", offsetof(DecisionRow, player), 1},
+    {"tokens", offsetof(DecisionRow, tokens), 16},
+    {"finished", offsetof(DecisionRow, finished), 2},
+    {"flags", offsetof(DecisionRow, flags), 1},
+    {"dice", offsetof(DecisionRow, dice), 1},
+    {"legal", offsetof(DecisionRow, legal), 1},
+    {"action", offsetof(DecisionRow, action), 1},
+    {"placement", offsetof(DecisionRow, placement), 1}
+};
+static const uint32_t DATASET_COLUMNS = sizeof(DATASET_FIELDS) / sizeof(DATASET_FIELDS[0]);
+
+DatasetWriter::DatasetWriter(const string& path, uint32_t chunkRows, bool compress)
+    : header{}
+{
+    file = fopen(path.c_str(), "wb");
+    if (!file) {
+        throw runtime_error("Cannot write " + path);
+    }
+
+    memcpy(header.magic, DATASET_MAGIC, sizeof(DATASET_MAGIC));
+    header.version = DATASET_VERSION;
+    header.columnCount = DATASET_COLUMNS;
+    header.chunkRows = chunkRows;
+    header.compression = compress ? 1 : 0;
+    for (uint32_t column = 0; column < DATASET_COLUMNS; ++column) {
+        strncpy(header.columns[column].name, DATASET_FIELDS[column].name, sizeof(header.columns[column].name) - 1);
+        header.columns[column].width = DATASET_FIELDS[column].width;
+    }
+
+    // Rewritten by close() once the row count and directory are known
+    fwrite(&header, sizeof(header), 1, file);
+}
+
+DatasetWriter::~DatasetWriter()
+{
+    close();
+}
+
+void DatasetWriter::writeAligned(const uint8_t* data, size_t size, DatasetBlock& entry)
+{
+    static const uint8_t zeros[64] = {};
+    long position = ftell(file);
+    fwrite(zeros, 1, (64 - position % 64) % 64, file);
+
+    entry.offset = ftell(file);
+    entry.size = size;
+    fwrite(data, 1, size, file);
+}
+
+void DatasetWriter::writeChunk(const vector<DecisionRow>& rows)
+{
+    // Transpose (and compress) outside the lock so workers only serialise on the write
+    vector<vector<uint8_t>> columnBlocks(DATASET_COLUMNS);
+    for (uint32_t column = 0; column < DATASET_COLUMNS; ++column) {
+        const DatasetField& field = DATASET_FIELDS[column];
+        vector<uint8_t>& block = columnBlocks[column];
+        block.resize(rows.size() * field.width);
+        for (size_t row = 0; row < rows.size(); ++row) {
+            memcpy(&block[row * field.width], reinterpret_cast<const uint8_t*>(&rows[row]) + field.offset, field.width);
+        }
+
+        if (header.compression) {
+            uLongf size = compressBound(block.size());
+            vector<uint8_t> packed(size);
+            if (compress2(packed.data(), &size, block.data(), block.size(), 6) != Z_OK) {
+                throw runtime_error("zlib compression failed");
+            }
+            packed.resize(size);
+            block.swap(packed);
+        }
+    }
+
+    lock_guard<mutex> lock(fileMutex);
+    chunks.push_back(DatasetChunk{header.rowCount, rows.size()});
+    for (uint32_t column = 0; column < DATASET_COLUMNS; ++column) {
+        DatasetBlock entry;
+        writeAligned(columnBlocks[column].data(), columnBlocks[column].size(), entry);
+        blocks.push_back(entry);
+    }
+    header.rowCount += rows.size();
+    header.chunkCount++;
+}
+
+void DatasetWriter::close()
+{
+    if (!file) {
+        return;
+    }
+
+    static const uint8_t zeros[64] = {};
+    long position = ftell(file);
+    fwrite(zeros, 1, (64 - position % 64) % 64, file);
+    header.directoryOffset = ftell(file);
+
+    for (size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+        fwrite(&chunks[chunk], sizeof(DatasetChunk), 1, file);
+        fwrite(&blocks[chunk * DATASET_COLUMNS], sizeof(DatasetBlock), DATASET_COLUMNS, file);
+    }
+
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, file);
+    fclose(file);
+    file = nullptr;
+}
+
+DatasetReader::DatasetReader(const string& path)
+    : cachedChunk(-1)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(DatasetHeader)) {
+        if (fd >= 0) ::close(fd);
+        throw runtime_error("Cannot read " + path);
+    }
+
+    mappedBytes = info.st_size;
+    void* memory = mmap(nullptr, mappedBytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        throw runtime_error("Cannot map " + path);
+    }
+
+    data = static_cast<const uint8_t*>(memory);
+    header = reinterpret_cast<const DatasetHeader*>(data);
+    size_t entryBytes = sizeof(DatasetChunk) + header->columnCount * sizeof(DatasetBlock);
+    if (memcmp(header->magic, DATASET_MAGIC, sizeof(DATASET_MAGIC)) != 0 || header->version != DATASET_VERSION ||
+        header->columnCount != DATASET_COLUMNS ||
+        header->directoryOffset + header->chunkCount * entryBytes > mappedBytes) {
+        munmap(memory, mappedBytes);
+        throw runtime_error(path + " is not a complete decision dataset");
+    }
+    directory = reinterpret_cast<const DatasetChunk*>(data + header->directoryOffset);
+    cachedBlocks.resize(DATASET_COLUMNS);
+}
+
+DatasetReader::~DatasetReader()
+{
+    munmap(const_cast<uint8_t*>(data), mappedBytes);
+}
+
+const DatasetChunk& DatasetReader::chunk(uint64_t chunkIndex) const
+{
+    size_t entryBytes = sizeof(DatasetChunk) + DATASET_COLUMNS * sizeof(DatasetBlock);
+    return *reinterpret_cast<const DatasetChunk*>(reinterpret_cast<const uint8_t*>(directory) + chunkIndex * entryBytes);
+}
+
+const DatasetBlock* DatasetReader::chunkBlocks(uint64_t chunkIndex) const
+{
+    return reinterpret_cast<const DatasetBlock*>(&chunk(chunkIndex) + 1);
+}
+
+DecisionRow DatasetReader::row(uint64_t index)
+{
+    if (index >= header->rowCount) {
+        throw runtime_error("Row " + to_string(index) + " is past the end of the dataset");
+    }
+
+    // Last chunk starting at or before the row
+    uint64_t low = 0, high = header->chunkCount;
+    while (high - low > 1) {
+        uint64_t middle = (low + high) / 2;
+        (chunk(middle).firstRow <= index ? low : high) = middle;
+    }
+    const DatasetChunk& entry = chunk(low);
+    const DatasetBlock* blocks = chunkBlocks(low);
+    uint64_t offset = index - entry.firstRow;
+
+    if (header->compression && cachedChunk != static_cast<int64_t>(low)) {
+        for (uint32_t column = 0; column < DATASET_COLUMNS; ++column) {
+            uLongf size = entry.rows * DATASET_FIELDS[column].width;
+            cachedBlocks[column].resize(size);
+            if (uncompress(cachedBlocks[column].data(), &size, data + blocks[column].offset, blocks[column].size) != Z_OK) {
+                throw runtime_error("Corrupt block in chunk " + to_string(low));
+            }
+        }
+        cachedChunk = low;
+    }
+
+    DecisionRow result = {};
+    for (uint32_t column = 0; column < DATASET_COLUMNS; ++column) {
+        const DatasetField& field = DATASET_FIELDS[column];
+        const uint8_t* block = header->compression ? cachedBlocks[column].data() : data + blocks[column].offset;
+        memcpy(reinterpret_cast<uint8_t*>(&result) + field.offset, block + offset * field.width, field.width);
+    }
+    return result;
+}
+
+struct DatasetWorkerParams {
+    const DatasetConfig* config;
+    const StrategyWeights* weights;
+    DatasetWriter* writer;
+    long long firstGame;
+};
+
+static DecisionRow packDecision(uint32_t game, const GameState& state, int player, int legal, int token)
+{
+    DecisionRow row = {};
+    row.game = game;
+    row.turn = static_cast<uint32_t>(state.turn);
+    row.player = static_cast<uint8_t>(player);
+    for (int other = 0; other < LudoBoard::MAX_PLAYERS; ++other) {
+        for (int i = 0; i < LudoBoard::MAX_TOKENS_PER_PLAYER; ++i) {
+            row.tokens[other][i] = state.tokens[other][i];
+            row.finished |= state.finished[other][i] << (other * 4 + i);
+        }
+        row.flags |= state.killers[other] << other;
+        row.flags |= state.eliminated[other] << (other + 4);
+    }
+    row.dice = static_cast<uint8_t>(state.diceValue);
+    row.legal = static_cast<uint8_t>(legal);
+    row.action = static_cast<uint8_t>(token);
+    row.placement = -1;
+    return row;
+}
+
+template <class Rules>
+void* datasetWorker(void* arg)
+{
+    WorkQueue* queue = static_cast<WorkQueue*>(arg);
+    DatasetWorkerParams* params = static_cast<DatasetWorkerParams*>(queue->context);
+    const DatasetConfig& config = *params->config;
+    int numPlayers = config.batch.rules.numPlayers;
+
+    LudoEngine<Rules> engine;
+    GameState& state = engine.state();
+    mt19937 policy;
+    vector<DecisionRow> chunk;
+    vector<DecisionRow> gameRows;
+    chunk.reserve(config.chunkRows);
+
+    size_t index;
+    while (queue->claim(index)) {
+        long long game = params->firstGame + static_cast<long long>(index);
+        uint32_t seed = static_cast<uint32_t>(config.batch.seed + game);
+        engine.reset(numPlayers, seed);
+        policy.seed(seed ^ 0x85ebca6bu);
+        gameRows.clear();
+
+        while (!engine.gameIsOver() && state.turn < config.batch.maxTurns) {
+            int player = state.currentPlayer;
+            if (engine.shouldSkipTurn(player)) {
+                engine.advanceTurn();
+                continue;
+            }
+
+            engine.rollDice();
+            int legal = engine.legalMoves(player);
+            int token = 0;
+            if (legal == 0) {
+                // Nothing moves: not a decision, play the turn out
+                while (state.finished[player][token]) {
+                    token++;
+                }
+            } else if (params->weights) {
+                token = chooseHeuristicToken(engine, player, *params->weights);
+                gameRows.push_back(packDecision(static_cast<uint32_t>(game), state, player, legal, token));
+            } else {
+                // Uniform over the tokens the dice actually moves
+                int pick = uniform_int_distribution<>(0, __builtin_popcount(legal) - 1)(policy);
+                token = __builtin_ctz(legal);
+                while (pick-- > 0) {
+                    token = __builtin_ctz(legal & ~((2 << token) - 1));
+                }
+                gameRows.push_back(packDecision(static_cast<uint32_t>(game), state, player, legal, token));
+            }
+            engine.moveToken(player, token);
+        }
+
+        for (DecisionRow& row : gameRows) {
+            for (int place = 0; place < state.finishedPlayers; ++place) {
+                if (state.finishingOrder[place] == row.player) {
+                    row.placement = static_cast<int8_t>(place);
+                }
+            }
+            chunk.push_back(row);
+            if (chunk.size() == config.chunkRows) {
+                params->writer->writeChunk(chunk);
+                chunk.clear();
+            }
+        }
+    }
+
+    if (!chunk.empty()) {
+        params->writer->writeChunk(chunk);
+    }
+    return nullptr;
+}
+
+uint64_t exportDataset(const DatasetConfig& config)
+{
+    const BatchConfig& batch = config.batch;
+    long long lastGame = batch.lastGame < 0 ? batch.games : batch.lastGame;
+
+    vector<StrategyWeights> weights;
+    if (!config.weightsPath.empty()) {
+        weights = loadWeights(config.weightsPath);
+        if (weights.empty()) {
+            throw runtime_error("No weights in " + config.weightsPath);
+        }
+    }
+
+    void* (*worker)(void*) = nullptr;
+    dispatchRules(batch.rules, [&](auto rules) {
+        worker = &datasetWorker<decltype(rules)>;
+    });
+
+    DatasetWriter writer(config.outputPath, config.chunkRows, config.compress);
+    DatasetWorkerParams params{&config, weights.empty() ? nullptr : &weights[0], &writer, batch.firstGame};
+    WorkQueue queue{&params, static_cast<size_t>(max(0LL, lastGame - batch.firstGame))};
+    runWorkQueue(batch.threads, worker, queue);
+
+    writer.close();
+    return writer.rowCount();
+}
+
+void printDatasetInfo(const string& path, long long row)
+{
+    DatasetReader reader(path);
+    const DatasetHeader& header = reader.info();
+
+    cout << path << ": " << header.rowCount << " rows in " << header.chunkCount << " chunks of up to "
+         << header.chunkRows << (header.compression ? ", zlib" : ", uncompressed") << endl;
+    for (uint32_t column = 0; column < header.columnCount; ++column) {
+        cout << "  " << header.columns[column].name << " (" << header.columns[column].width << " bytes)" << endl;
+    }
+
+    if (row >= 0) {
+        DecisionRow decision = reader.row(row);
+        cout << "Row " << row << ": game " << decision.game << ", turn " << decision.turn
+             << ", player " << decision.player + 1 << ", dice " << int(decision.dice)
+             << ", legal " << int(decision.legal) << ", action " << int(decision.action)
+             << ", placement " << int(decision.placement) << ", tokens";
+        for (int i = 0; i < LudoBoard::MAX_PLAYERS * LudoBoard::MAX_TOKENS_PER_PLAYER; ++i) {
+            cout << " " << int(decision.tokens[i / 4][i % 4]);
+        }
+        cout << endl;
+    }
+}
+
+DatasetConfig parseDatasetOptions(int argc, char* argv[], int first)
+{
+    DatasetConfig config;
+    vector<char*> batchOptions;
+
+    for (int i = first; i < argc; ++i) {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (option == "--out" && hasValue) {
+            config.outputPath = argv[++i];
+        } else if (option == "--compress") {
+            config.compress = true;
+        } else if (option == "--chunk-rows" && hasValue) {
+            config.chunkRows = static_cast<uint32_t>(stoul(argv[++i]));
+        } else if (option == "--weights" && hasValue) {
+            config.weightsPath = argv[++i];
+        } else {
+            batchOptions.push_back(argv[i]);
+        }
+    }
+
+    config.batch = parseBatchOptions(static_cast<int>(batchOptions.size()), batchOptions.data(), 0);
+    if (config.chunkRows == 0) {
+        throw runtime_error("Chunk rows must be positive.");
+    }
+    return config;
+}
@@ -0,0 +1,129 @@
+#ifndef DATASET_EXPORT_HPP
+#define DATASET_EXPORT_HPP
+
+#pragma once
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <zlib.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ludo_engine.hpp"
+#include "batch_simulator.hpp"
+#include "strategy_tuner.hpp"
+
+using namespace std;
+
+// One decision point: the player to move had at least one token the dice could move
+struct DecisionRow {
+    uint32_t game;
+    uint32_t turn;
+    uint8_t player;
+    uint8_t tokens[LudoBoard::MAX_PLAYERS][LudoBoard::MAX_TOKENS_PER_PLAYER];  // row*15+column
+    uint16_t finished;          // bit player*4+token
+    uint8_t flags;              // killers in bits 0-3, eliminated players in bits 4-7
+    uint8_t dice;
+    uint8_t legal;              // bit per token the dice moves
+    uint8_t action;             // token chosen
+    int8_t placement;           // mover's index in finishingOrder at game end, -1 if unplaced
+};
+
+// File layout, all little-endian:
+//   DatasetHeader at offset 0
+//   chunks: per chunk, one contiguous block per column (zlib-compressed when the
+//     header says so), each block starting on a 64-byte boundary
+//   directory at header.directoryOffset: per chunk a DatasetChunk followed by
+//     columnCount DatasetBlock entries
+// Uncompressed blocks are plain arrays, so a reader maps the file and reads row r
+// of column c at block.offset + (r - chunk.firstRow) * width.
+struct DatasetColumn {
+    char name[12];
+    uint32_t width;             // bytes per row
+};
+
+struct DatasetHeader {
+    char magic[8];              // "LUDOCOL1"
+    uint32_t version;
+    uint32_t columnCount;
+    uint32_t chunkRows;         // rows per full chunk
+    uint32_t compression;       // 0 = none, 1 = zlib per block
+    uint64_t rowCount;
+    uint64_t chunkCount;
+    uint64_t directoryOffset;
+    DatasetColumn columns[16];
+};
+
+struct DatasetChunk {
+    uint64_t firstRow;
+    uint64_t rows;
+};
+
+struct DatasetBlock {
+    uint64_t offset;
+    uint64_t size;              // stored bytes
+};
+
+struct DatasetConfig {
+    BatchConfig batch;          // rules, games, seed, threads, max turns
+    string outputPath = "decisions.ludocol";
+    bool compress = false;
+    uint32_t chunkRows = 65536;
+    string weightsPath;         // heuristic weights for every seat; empty = random legal tokens
+};
+
+// Appends whole chunks from any thread. Chunks keep the order they are written in.
+class DatasetWriter {
+public:
+    DatasetWriter(const string& path, uint32_t chunkRows, bool compress);
+    ~DatasetWriter();
+
+    void writeChunk(const vector<DecisionRow>& rows);
+    void close();               // writes the directory and final header
+    uint64_t rowCount() const { return header.rowCount; }
+
+private:
+    FILE* file;
+    mutex fileMutex;
+    DatasetHeader header;
+    vector<DatasetChunk> chunks;
+    vector<DatasetBlock> blocks;
+
+    void writeAligned(const uint8_t* data, size_t size, DatasetBlock& entry);
+};
+
+// Maps a dataset and reads single rows by index without loading the file
+class DatasetReader {
+public:
+    explicit DatasetReader(const string& path);
+    ~DatasetReader();
+
+    uint64_t rowCount() const { return header->rowCount; }
+    const DatasetHeader& info() const { return *header; }
+    DecisionRow row(uint64_t index);
+
+private:
+    size_t mappedBytes;
+    const uint8_t* data;
+    const DatasetHeader* header;
+    const DatasetChunk* directory;
+    int64_t cachedChunk;
+    vector<vector<uint8_t>> cachedBlocks;  // decompressed columns of cachedChunk
+
+    const DatasetChunk& chunk(uint64_t chunkIndex) const;
+    const DatasetBlock* chunkBlocks(uint64_t chunkIndex) const;
+};
+
+// Plays config.batch games on all cores and writes every decision point
+uint64_t exportDataset(const DatasetConfig& config);
+void printDatasetInfo(const string& path, long long row);
+
+DatasetConfig parseDatasetOptions(int argc, char* argv[], int first);
+
+#endif // DATASET_EXPORT_HPP
@@ -0,0 +1,218 @@
+#include "event_log.hpp"
+
+static const char EVENT_LOG_MAGIC[8] = {'L', 'U', 'D', 'O', 'L', 'O', 'G', '1'};
+
+EventLog& EventLog::get()
+{
+    static EventLog log;
+    return log;
+}
+
+EventLog::EventLog()
+    : head(0),
+      tail(0),
+      minLevel(LOG_OFF),
+      running(false),
+      droppedRecords(0),
+      output(nullptr),
+      binary(false)
+{
+    for (uint64_t i = 0; i < CAPACITY; ++i) {
+        slots[i].sequence.store(i, memory_order_relaxed);
+    }
+}
+
+void EventLog::start(const EventLogConfig& config)
+{
+    if (running || config.level == LOG_OFF) {
+        return;
+    }
+
+    output = config.path.empty() ? stdout : fopen(config.path.c_str(), config.binary ? "wb" : "w");
+    if (!output) {
+        throw runtime_error("Cannot write " + config.path);
+    }
+
+    binary = config.binary;
+    if (binary) {
+        uint32_t header[2] = {sizeof(LogRecord), 0};
+        fwrite(EVENT_LOG_MAGIC, 1, sizeof(EVENT_LOG_MAGIC), output);
+        fwrite(header, sizeof(header), 1, output);
+    }
+
+    startTime = chrono::steady_clock::now();
+    running = true;
+    pthread_create(&writer, nullptr, EventLog::writerThread, this);
+    minLevel.store(config.level, memory_order_release);
+}
+
+void EventLog::stop()
+{
+    if (!running) {
+        return;
+    }
+
+    minLevel.store(LOG_OFF, memory_order_release);
+    running = false;
+    pthread_join(writer, nullptr);
+
+    if (output != stdout) {
+        fclose(output);
+    }
+    output = nullptr;
+
+    if (dropped() > 0) {
+        fprintf(stderr, "Event log dropped %lld records\n", dropped());
+    }
+}
+
+void EventLog::record(LogLevel level, LogEvent event, int player, int target, int token, int cell)
+{
+    LogRecord entry;
+    entry.timestampUs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count();
+    entry.level = static_cast<uint8_t>(level);
+    entry.event = static_cast<uint8_t>(event);
+    entry.player = static_cast<int8_t>(player);
+    entry.target = static_cast<int8_t>(target);
+    entry.token = static_cast<int8_t>(token);
+    entry.cell = cell < 0 ? NO_CELL : static_cast<uint8_t>(cell);
+    entry.reserved = 0;
+
+    // Claim a slot whose sequence says it is free; give up rather than wait for the writer
+    uint64_t position = head.load(memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &slots[position & (CAPACITY - 1)];
+        int64_t difference = static_cast<int64_t>(slot->sequence.load(memory_order_acquire) - position);
+        if (difference == 0) {
+            if (head.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            droppedRecords.fetch_add(1, memory_order_relaxed);
+            return;
+        } else {
+            position = head.load(memory_order_relaxed);
+        }
+    }
+
+    slot->record = entry;
+    slot->sequence.store(position + 1, memory_order_release);
+}
+
+bool EventLog::pop(LogRecord& record)
+{
+    Slot& slot = slots[tail & (CAPACITY - 1)];
+    if (slot.sequence.load(memory_order_acquire) != tail + 1) {
+        return false;
+    }
+
+    record = slot.record;
+    slot.sequence.store(tail + CAPACITY, memory_order_release);
+    tail++;
+    return true;
+}
+
+void* EventLog::writerThread(void* arg)
+{
+    EventLog* log = static_cast<EventLog*>(arg);
+    LogRecord record;
+
+    while (true) {
+        bool stopping = !log->running;
+        int written = 0;
+        while (log->pop(record)) {
+            if (log->binary) {
+                fwrite(&record, sizeof(record), 1, log->output);
+            } else {
+                writeJson(log->output, record);
+            }
+            written++;
+        }
+
+        if (written > 0) {
+            fflush(log->output);
+        } else if (stopping) {
+            break;
+        } else {
+            this_thread::sleep_for(chrono::milliseconds(2));
+        }
+    }
+
+    return nullptr;
+}
+
+void EventLog::writeJson(FILE* out, const LogRecord& record)
+{
+    static const char* const levels[] = {"debug", "info", "warn"};
+    static const char* const events[] = {"move", "capture", "elimination", "turn_passed", "no_moves", "missed_capture"};
+
+    // Players are numbered from 1 as in the GUI
+    fprintf(out, "{\"t_us\":%llu,\"level\":\"%s\",\"event\":\"%s\",\"player\":%d",
+            static_cast<unsigned long long>(record.timestampUs), levels[record.level], events[record.event], record.player + 1);
+    if (record.target >= 0) {
+        fprintf(out, ",\"target\":%d", record.target + 1);
+    }
+    if (record.token >= 0) {
+        fprintf(out, ",\"token\":%d", record.token);
+    }
+    if (record.cell != NO_CELL) {
+        fprintf(out, ",\"row\":%d,\"column\":%d", record.cell / LudoBoard::BOARD_SIZE, record.cell % LudoBoard::BOARD_SIZE);
+    }
+    fputs("}\n", out);
+}
+
+void dumpEventLog(const string& path)
+{
+    FILE* in = fopen(path.c_str(), "rb");
+    if (!in) {
+        throw runtime_error("Cannot read " + path);
+    }
+
+    char magic[sizeof(EVENT_LOG_MAGIC)];
+    uint32_t header[2];
+    if (fread(magic, sizeof(magic), 1, in) != 1 || fread(header, sizeof(header), 1, in) != 1 ||
+        !equal(magic, magic + sizeof(magic), EVENT_LOG_MAGIC) || header[0] != sizeof(LogRecord)) {
+        fclose(in);
+        throw runtime_error(path + " is not a binary event log");
+    }
+
+    LogRecord record;
+    while (fread(&record, sizeof(record), 1, in) == 1) {
+        EventLog::writeJson(stdout, record);
+    }
+    fclose(in);
+}
+
+EventLogConfig parseLogOptions(int argc, char* argv[], int first)
+{
+    EventLogConfig config;
+
+    for (int i = first; i < argc; ++i) {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (option == "--log" && hasValue) {
+            config.path = argv[++i];
+        } else if (option == "--log-format" && hasValue) {
+            string format = argv[++i];
+            if (format != "json" && format != "binary") {
+                throw runtime_error("Unknown log format: " + format);
+            }
+            config.binary = format == "binary";
+        } else if (option == "--log-level" && hasValue) {
+            static const char* const names[] = {"debug", "info", "warn", "off"};
+            string level = argv[++i];
+            const char* const* match = find(names, names + 4, level);
+            if (match == names + 4) {
+                throw runtime_error("Unknown log level: " + level);
+            }
+            config.level = static_cast<LogLevel>(match - names);
+        }
+    }
+
+    if (config.binary && config.path.empty()) {
+        throw runtime_error("--log-format binary needs --log PATH");
+    }
+    return config;
+}
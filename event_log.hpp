@@ -0,0 +1,114 @@
+#ifndef EVENT_LOG_HPP
+#define EVENT_LOG_HPP
+
+#pragma once
+
+#include <pthread.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "ludo_engine.hpp"
+
+using namespace std;
+
+enum LogLevel {
+    LOG_DEBUG,
+    LOG_INFO,
+    LOG_WARN,
+    LOG_OFF
+};
+
+enum LogEvent {
+    EVENT_MOVE,                 // player moved token to cell
+    EVENT_CAPTURE,              // player sent target's token back to the yard from cell
+    EVENT_ELIMINATION,          // player removed for inactivity
+    EVENT_TURN_PASSED,          // player finished, target plays on for the team
+    EVENT_NO_MOVES,             // player has no tokens left to move
+    EVENT_MISSED_CAPTURE        // target's token was left on the cell player landed on (engine bug)
+};
+
+// Fixed-size record; the binary log is a header followed by these, unformatted
+struct LogRecord {
+    uint64_t timestampUs;       // since EventLog::start
+    uint8_t level;
+    uint8_t event;
+    int8_t player;
+    int8_t target;              // -1 when unused
+    int8_t token;
+    uint8_t cell;               // 0xFF when unused
+    uint16_t reserved;
+};
+static_assert(sizeof(LogRecord) == 16, "LogRecord is written to disk as-is");
+
+struct EventLogConfig {
+    string path;                // empty = stdout
+    bool binary = false;        // JSON lines otherwise
+    LogLevel level = LOG_INFO;
+};
+
+// Structured game event log. Producers claim a slot in a bounded lock-free ring and
+// never block: when the ring is full the record is dropped and counted. A background
+// writer formats and writes batches. Until start() the level is LOG_OFF, so headless
+// batch runs pay one relaxed load per call site.
+class EventLog {
+public:
+    static const uint64_t CAPACITY = 8192;
+    static const uint8_t NO_CELL = 0xFF;
+
+    static EventLog& get();
+
+    void start(const EventLogConfig& config);
+    void stop();                // drains the ring and joins the writer
+
+    bool enabled(LogLevel level) const { return level >= minLevel.load(memory_order_relaxed); }
+    void record(LogLevel level, LogEvent event, int player, int target, int token, int cell);
+    long long dropped() const { return droppedRecords.load(memory_order_relaxed); }
+
+    static void writeJson(FILE* out, const LogRecord& record);
+
+private:
+    struct Slot {
+        atomic<uint64_t> sequence;
+        LogRecord record;
+    };
+
+    EventLog();
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    static void* writerThread(void* arg);
+    bool pop(LogRecord& record);
+
+    Slot slots[CAPACITY];
+    alignas(64) atomic<uint64_t> head;          // next slot producers claim
+    alignas(64) uint64_t tail;                  // writer thread only
+    atomic<int> minLevel;
+    atomic<bool> running;
+    atomic<long long> droppedRecords;
+    chrono::steady_clock::time_point startTime;
+    FILE* output;
+    bool binary;
+    pthread_t writer;
+};
+
+inline void logEvent(LogLevel level, LogEvent event, int player, int target = -1, int token = -1, int cell = -1)
+{
+    EventLog& log = EventLog::get();
+    if (log.enabled(level)) {
+        log.record(level, event, player, target, token, cell);
+    }
+}
+
+// Prints a binary log as JSON lines
+void dumpEventLog(const string& path);
+
+// Parses "--log PATH --log-format json|binary --log-level debug|info|warn|off" from
+// argv[first], skipping anything else
+EventLogConfig parseLogOptions(int argc, char* argv[], int first);
+
+#endif // EVENT_LOG_HPP
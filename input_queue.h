@@ -0,0 +1,49 @@
+#include "input_queue.hpp"
+
+template <class T, size_t Capacity>
+bool SpscQueue<T, Capacity>::push(const T& item)
+{
+    size_t write = head.load(memory_order_relaxed);
+    if (write - tail.load(memory_order_acquire) == Capacity) {
+        return false;
+    }
+
+    items[write & (Capacity - 1)] = item;
+    head.store(write + 1, memory_order_release);
+    return true;
+}
+
+template <class T, size_t Capacity>
+bool SpscQueue<T, Capacity>::pop(T& item)
+{
+    size_t read = tail.load(memory_order_relaxed);
+    if (read == head.load(memory_order_acquire)) {
+        return false;
+    }
+
+    item = items[read & (Capacity - 1)];
+    tail.store(read + 1, memory_order_release);
+    return true;
+}
+
+void LatencyTracker::add(double milliseconds)
+{
+    samples[total % SAMPLES] = milliseconds;
+    total++;
+}
+
+bool LatencyTracker::percentiles(double& p50, double& p99) const
+{
+    int count = static_cast<int>(min<long long>(total, SAMPLES));
+    if (count == 0) {
+        return false;
+    }
+
+    double sorted[SAMPLES];
+    copy(samples, samples + count, sorted);
+    nth_element(sorted, sorted + count / 2, sorted + count);
+    p50 = sorted[count / 2];
+    nth_element(sorted, sorted + count * 99 / 100, sorted + count);
+    p99 = sorted[count * 99 / 100];
+    return true;
+}
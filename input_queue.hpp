@@ -0,0 +1,59 @@
+#ifndef INPUT_QUEUE_HPP
+#define INPUT_QUEUE_HPP
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+// Bounded single-producer, single-consumer ring. push and pop never block or lock;
+// the producer and consumer each own one index and publish it with release stores.
+template <class T, size_t Capacity>
+class SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    bool push(const T& item);   // producer thread only; false when full
+    bool pop(T& item);          // consumer thread only; false when empty
+
+private:
+    alignas(64) atomic<size_t> head{0};     // next slot to write
+    alignas(64) atomic<size_t> tail{0};     // next slot to read
+    T items[Capacity];
+};
+
+enum InputType {
+    INPUT_CLICK,
+    INPUT_TURN_TIMEOUT,
+    INPUT_UNDO,
+    INPUT_REDO,
+    INPUT_QUIT
+};
+
+struct InputEvent {
+    InputType type;
+    int x;
+    int y;
+    uint64_t sequence;          // clicks only, used to match the frame that shows them
+    int turnKey;                // timeouts only, stale timeouts are dropped
+};
+
+// Keeps the last SAMPLES latencies for percentile reporting
+class LatencyTracker {
+public:
+    static const int SAMPLES = 1024;
+
+    void add(double milliseconds);
+    bool percentiles(double& p50, double& p99) const;
+    long long count() const { return total; }
+
+private:
+    double samples[SAMPLES];
+    long long total = 0;
+};
+
+#endif // INPUT_QUEUE_HPP
@@ -0,0 +1,512 @@
+#include "ludo_engine.hpp"
+
+LudoBoard::LudoBoard()
+{
+    const int ludoPathCells[LUDO_PATH_LENGTH][2] = {
+        {6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5}, {5, 6}, {4, 6}, {3, 6}, {2, 6}, {1, 6}, {0, 6}, {0, 7}, {0, 8}, {1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8}, {6, 9}, {6, 10}, {6, 11}, {6, 12}, {6, 13}, {6, 14}, {7, 14}, {8, 14}, {8, 13}, {8, 12}, {8, 11}, {8, 10}, {8, 9}, {9, 8}, {10, 8}, {11, 8}, {12, 8}, {13, 8}, {14, 8}, {14, 7}, {14, 6}, {13, 6}, {12, 6}, {11, 6}, {10, 6}, {9, 6}, {8, 5}, {8, 4}, {8, 3}, {8, 2}, {8, 1}, {8, 0}, {7, 0}, {6, 0}
+    };
+
+    const int killersPathCells[MAX_PLAYERS][KILLER_PATH_LENGTH][2] = {
+        // Red
+        {{6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5}, {5, 6}, {4, 6}, {3, 6}, {2, 6}, {1, 6}, {0, 6}, {0, 7}, {0, 8}, {1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8}, {6, 9}, {6, 10}, {6, 11}, {6, 12}, {6, 13}, {6, 14}, {7, 14}, {8, 14}, {8, 13}, {8, 12}, {8, 11}, {8, 10}, {8, 9}, {9, 8}, {10, 8}, {11, 8}, {12, 8}, {13, 8}, {14, 8}, {14, 7}, {14, 6}, {13, 6}, {12, 6}, {11, 6}, {10, 6}, {9, 6}, {8, 5}, {8, 4}, {8, 3}, {8, 2}, {8, 1}, {8, 0}, {7, 0}, {7, 1}, {7, 2}, {7, 3}, {7, 4}, {7, 5}, {7, 6}},
+        // Green
+        {{1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8}, {6, 9}, {6, 10}, {6, 11}, {6, 12}, {6, 13}, {6, 14}, {7, 14}, {8, 14}, {8, 13}, {8, 12}, {8, 11}, {8, 10}, {8, 9}, {9, 8}, {10, 8}, {11, 8}, {12, 8}, {13, 8}, {14, 8}, {14, 7}, {14, 6}, {13, 6}, {12, 6}, {11, 6}, {10, 6}, {9, 6}, {8, 5}, {8, 4}, {8, 3}, {8, 2}, {8, 1}, {8, 0}, {7, 0}, {6, 0}, {6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5}, {5, 6}, {4, 6}, {3, 6}, {2, 6}, {1, 6}, {0, 6}, {0, 7}, {1, 7}, {2, 7}, {3, 7}, {4, 7}, {5, 7}, {6, 7}},
+        // Blue
+        {{8, 13}, {8, 12}, {8, 11}, {8, 10}, {8, 9}, {9, 8}, {10, 8}, {11, 8}, {12, 8}, {13, 8}, {14, 8}, {14, 7}, {14, 6}, {13, 6}, {12, 6}, {11, 6}, {10, 6}, {9, 6}, {8, 5}, {8, 4}, {8, 3}, {8, 2}, {8, 1}, {8, 0}, {7, 0}, {6, 0}, {6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5}, {5, 6}, {4, 6}, {3, 6}, {2, 6}, {1, 6}, {0, 6}, {0, 7}, {0, 8}, {1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8}, {6, 9}, {6, 10}, {6, 11}, {6, 12}, {6, 13}, {6, 14}, {7, 14}, {7, 13}, {7, 12}, {7, 11}, {7, 10}, {7, 9}, {7, 8}},
+        // Yellow
+        {{13, 6}, {12, 6}, {11, 6}, {10, 6}, {9, 6}, {8, 5}, {8, 4}, {8, 3}, {8, 2}, {8, 1}, {8, 0}, {7, 0}, {6, 0}, {6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5}, {5, 6}, {4, 6}, {3, 6}, {2, 6}, {1, 6}, {0, 6}, {0, 7}, {0, 8}, {1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8}, {6, 9}, {6, 10}, {6, 11}, {6, 12}, {6, 13}, {6, 14}, {7, 14}, {8, 14}, {8, 13}, {8, 12}, {8, 11}, {8, 10}, {8, 9}, {9, 8}, {10, 8}, {11, 8}, {12, 8}, {13, 8}, {14, 8}, {14, 7}, {13, 7}, {12, 7}, {11, 7}, {10, 7}, {9, 7}, {8, 7}}
+    };
+
+    const int startCells[MAX_PLAYERS * MAX_TOKENS_PER_PLAYER][2] = {
+        {1, 1}, {1, 2}, {2, 1}, {2, 2}, // Red
+        {1, 12}, {1, 13}, {2, 12}, {2, 13}, // Green
+        {12, 12}, {12, 13}, {13, 12}, {13, 13}, // Yellow
+        {12, 1}, {12, 2}, {13, 1}, {13, 2} // Blue
+    };
+
+    const int safeCells[8][2] = {
+        {2, 6}, {6, 1}, {8, 2}, {13, 6}, {12, 8}, {8, 13}, {6, 12}, {1, 8}
+    };
+
+    for (int i = 0; i < LUDO_PATH_LENGTH; ++i) {
+        ludoPath[i] = cell(ludoPathCells[i][0], ludoPathCells[i][1]);
+    }
+    for (int player = 0; player < MAX_PLAYERS; ++player) {
+        for (int i = 0; i < KILLER_PATH_LENGTH; ++i) {
+            killersPath[player][i] = cell(killersPathCells[player][i][0], killersPathCells[player][i][1]);
+        }
+    }
+    for (int i = 0; i < MAX_PLAYERS * MAX_TOKENS_PER_PLAYER; ++i) {
+        playerStartPositions[i] = cell(startCells[i][0], startCells[i][1]);
+    }
+    for (int i = 0; i < 8; ++i) {
+        safeZones[i] = cell(safeCells[i][0], safeCells[i][1]);
+    }
+
+    // First exact match on the path, otherwise the first cell at minimal Manhattan distance
+    auto indexOnPath = [](const uint8_t* path, int length, int position) {
+        int best = 0;
+        int bestDistance = CELL_COUNT;
+        for (int i = 0; i < length; ++i) {
+            int distance = abs(row(path[i]) - row(position)) + abs(column(path[i]) - column(position));
+            if (distance < bestDistance) {
+                best = i;
+                bestDistance = distance;
+            }
+        }
+        return static_cast<uint8_t>(best);
+    };
+
+    for (int position = 0; position < CELL_COUNT; ++position) {
+        ludoPathIndex[position] = indexOnPath(ludoPath, LUDO_PATH_LENGTH, position);
+        for (int player = 0; player < MAX_PLAYERS; ++player) {
+            killersPathIndex[player][position] = indexOnPath(killersPath[player], KILLER_PATH_LENGTH, position);
+        }
+        safeZone[position] = find(safeZones, safeZones + 8, position) != safeZones + 8;
+        yardOwner[position] = -1;
+    }
+    for (int i = 0; i < MAX_PLAYERS * MAX_TOKENS_PER_PLAYER; ++i) {
+        yardOwner[playerStartPositions[i]] = i / MAX_TOKENS_PER_PLAYER;
+    }
+}
+
+const LudoBoard& LudoBoard::get()
+{
+    static const LudoBoard board;
+    return board;
+}
+
+CellKind LudoBoard::cellKind(int i, int j)
+{
+    if (i < 6 && j < 6)
+        return CELL_RED;
+    else if (i > 8 && j < 6)
+        return CELL_YELLOW;
+    else if (i < 6 && j > 8)
+        return CELL_GREEN;
+    else if (i > 8 && j > 8)
+        return CELL_BLUE;
+    else if (i == 7 && j >= 1 && j <= 6)
+        return CELL_RED;
+    else if (j == 7 && i >= 1 && i <= 6)
+        return CELL_GREEN;
+    else if (i == 7 && j >= 8 && j <= 13)
+        return CELL_BLUE;
+    else if (j == 7 && i >= 8 && i <= 13)
+        return CELL_YELLOW;
+    else if ((i == 7 && j == 7) || (i == 6 && j == 6) || (i == 6 && j == 8) || (i == 8 && j == 6) || (i == 8 && j == 8))
+        return CELL_BLACK;
+    else if ((i == 2 && j == 6) || (i == 6 && j == 1) || (i == 13 && j == 6) || (i == 8 && j == 13) || (i == 6 && j == 12) || (i == 12 && j == 8) || (i == 8 && j == 2) || (i == 1 && j == 8))
+        return CELL_GREY;
+    else
+        return CELL_WHITE;
+}
+
+bool RulesEngine::allTokensHome(int player) const
+{
+    for (int token = 0; token < LudoBoard::MAX_TOKENS_PER_PLAYER; ++token) {
+        if (!gameState.finished[player][token]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RulesEngine::hasFinished(int player) const
+{
+    for (int i = 0; i < gameState.finishedPlayers; ++i) {
+        if (gameState.finishingOrder[i] == player) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RulesEngine::finishPlayer(int player)
+{
+    if (!hasFinished(player)) {
+        gameState.finishingOrder[gameState.finishedPlayers++] = player;
+    }
+}
+
+void RulesEngine::eliminatePlayer(int player)
+{
+    if (!gameState.eliminated[player] && !hasFinished(player)) {
+        gameState.eliminated[player] = true;
+        gameState.eliminatedPlayers++;
+    }
+}
+
+void RulesEngine::unmakeMove(const MoveUndo& undo)
+{
+    const MoveResult& result = undo.result;
+
+    // Captured tokens all stood on the destination cell
+    for (uint16_t captured = result.capturedTokens; captured; captured &= captured - 1) {
+        int bit = __builtin_ctz(captured);
+        placeToken(bit / LudoBoard::MAX_TOKENS_PER_PLAYER, bit % LudoBoard::MAX_TOKENS_PER_PLAYER, result.to);
+    }
+    placeToken(undo.player, undo.tokenIndex, result.from);
+    if (result.tokenFinished) {
+        gameState.finished[undo.player][undo.tokenIndex] = false;
+    }
+
+    while (gameState.finishedPlayers > undo.finishedPlayers) {
+        gameState.finishingOrder[--gameState.finishedPlayers] = -1;
+    }
+    gameState.eliminated[undo.player] = undo.wasEliminated;
+    gameState.eliminatedPlayers = undo.eliminatedPlayers;
+    gameState.killers[undo.player] = undo.wasKiller;
+    gameState.consecutiveTurnsWithoutProgress[undo.player] = undo.consecutiveTurnsWithoutProgress;
+    gameState.currentPlayer = undo.currentPlayer;
+    gameState.diceValue = undo.diceValue;
+    gameState.diceRolled = undo.diceRolled;
+    gameState.turn--;
+}
+
+template <class Rules>
+void LudoEngine<Rules>::reset(int numPlayers, uint32_t seed)
+{
+    const LudoBoard& board = LudoBoard::get();
+
+    gameState = GameState();
+    gameState.numPlayers = numPlayers;
+    for (int player = 0; player < LudoBoard::MAX_PLAYERS; ++player) {
+        for (int token = 0; token < LudoBoard::MAX_TOKENS_PER_PLAYER; ++token) {
+            uint8_t yard = board.playerStartPositions[player * LudoBoard::MAX_TOKENS_PER_PLAYER + token];
+            gameState.tokens[player][token] = yard;
+            // Seats beyond numPlayers stay in their yards and are left out of occupancy
+            if (player < numPlayers) {
+                gameState.occupancy[yard] += 1 << (4 * player);
+            }
+        }
+        gameState.finishingOrder[player] = -1;
+    }
+
+    for (int player = 0; player < LudoBoard::MAX_PLAYERS; ++player) {
+        friendlyMask[player] = 0;
+        opponentMask[player] = 0;
+        for (int otherPlayer = 0; otherPlayer < numPlayers; ++otherPlayer) {
+            if (otherPlayer == player || Rules::Teams::areTeammates(player, otherPlayer)) {
+                friendlyMask[player] |= 0xF << (4 * otherPlayer);
+            } else {
+                opponentMask[player] |= 0xF << (4 * otherPlayer);
+            }
+        }
+    }
+
+    randomGenerator.seed(seed);
+}
+
+template <class Rules>
+int LudoEngine<Rules>::rollDice()
+{
+    uniform_int_distribution<> dis(1, 6);
+    gameState.diceValue = dis(randomGenerator);
+    gameState.diceRolled = true;
+    return gameState.diceValue;
+}
+
+template <class Rules>
+bool LudoEngine<Rules>::canLandOn(uint8_t position, int player) const
+{
+    if (isSafeZone(position)) {
+        return true;
+    }
+
+    uint16_t cell = gameState.occupancy[position];
+
+    // An opponent field of 2 or more has one of its upper three bits set
+    if (cell & opponentMask[player] & 0xEEEE) {
+        return false;
+    }
+
+    // Own plus teammate tokens may total at most one: a single field holding exactly 1
+    uint16_t friendly = cell & friendlyMask[player];
+    return friendly == 0 || ((friendly & (friendly - 1)) == 0 && (friendly & 0x1111));
+}
+
+template <class Rules>
+uint8_t LudoEngine<Rules>::moveTokenOnBoard(uint8_t token, int player, int tokenIndex)
+{
+    bool finishes = false;
+    uint8_t position = destination(token, player, finishes);
+    if (finishes) {
+        gameState.finished[player][tokenIndex] = true;
+    }
+    return position;
+}
+
+template <class Rules>
+uint8_t LudoEngine<Rules>::destination(uint8_t token, int player, bool& finishes) const
+{
+    const LudoBoard& board = LudoBoard::get();
+
+    // Without the killer rule every player is on its home path from the start
+    bool homeBound = !Rules::Killer::enabled || gameState.killers[player];
+    const uint8_t* path = homeBound ? board.killersPath[player] : board.ludoPath;
+    int pathLength = homeBound ? LudoBoard::KILLER_PATH_LENGTH : LudoBoard::LUDO_PATH_LENGTH;
+    int currentIndex = homeBound ? board.killersPathIndex[player][token] : board.ludoPathIndex[token];
+    int newIndex = currentIndex + gameState.diceValue;
+
+    if (newIndex >= pathLength) {
+        if (homeBound) {
+            finishes = true;
+            return token;
+        }
+        newIndex = newIndex % pathLength;
+    }
+
+    if (!Rules::Blockade::enabled) {
+        return path[newIndex];
+    }
+
+    while (newIndex < pathLength) {
+        uint8_t newPosition = path[newIndex];
+        if (canLandOn(newPosition, player)) {
+            return newPosition;
+        }
+        newIndex++;
+    }
+
+    return token;
+}
+
+template <class Rules>
+int LudoEngine<Rules>::legalMoves(int player) const
+{
+    int moves = 0;
+    for (int tokenIndex = 0; tokenIndex < LudoBoard::MAX_TOKENS_PER_PLAYER; ++tokenIndex) {
+        if (gameState.finished[player][tokenIndex]) continue;
+
+        uint8_t token = gameState.tokens[player][tokenIndex];
+        bool finishes = false;
+        if (isTokenInYard(token, player) ? gameState.diceValue == 6
+                                         : destination(token, player, finishes) != token || finishes) {
+            moves |= 1 << tokenIndex;
+        }
+    }
+    return moves;
+}
+
+template <class Rules>
+MoveResult LudoEngine<Rules>::moveToken(int player, int tokenIndex)
+{
+    const LudoBoard& board = LudoBoard::get();
+
+    MoveResult result = MoveResult();
+    uint8_t token = gameState.tokens[player][tokenIndex];
+    bool wasFinished = gameState.finished[player][tokenIndex];
+    result.from = token;
+
+    if (isTokenInYard(token, player)) {
+        if (gameState.diceValue == 6) {
+            token = board.ludoPath[player * LudoBoard::START_OFFSET];
+        }
+    } else {
+        token = moveTokenOnBoard(token, player, tokenIndex);
+    }
+    placeToken(player, tokenIndex, token);
+    result.to = token;
+    result.tokenFinished = !wasFinished && gameState.finished[player][tokenIndex];
+
+    uint16_t victims = gameState.occupancy[token] & opponentMask[player];
+    if (victims && !isSafeZone(token) && token != board.ludoPath[LudoBoard::LUDO_PATH_LENGTH - 1]) {
+        for (int otherPlayer = 0; otherPlayer < gameState.numPlayers; ++otherPlayer) {
+            if (!(victims & (0xF << (4 * otherPlayer)))) continue;
+
+            for (int otherToken = 0; otherToken < LudoBoard::MAX_TOKENS_PER_PLAYER; ++otherToken) {
+                if (gameState.tokens[otherPlayer][otherToken] != token) continue;
+
+                gameState.killers[player] = true;
+                result.capturedTokens |= 1 << (otherPlayer * LudoBoard::MAX_TOKENS_PER_PLAYER + otherToken);
+                for (int i = 0; i < LudoBoard::MAX_TOKENS_PER_PLAYER; ++i) {
+                    uint8_t yardPosition = board.playerStartPositions[otherPlayer * LudoBoard::MAX_TOKENS_PER_PLAYER + i];
+                    if (tokenCountAt(otherPlayer, yardPosition) == 0) {
+                        placeToken(otherPlayer, otherToken, yardPosition);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    if (result.tokenFinished && allTokensHome(player)) {
+        finishPlayer(player);
+        result.playerFinished = true;
+    }
+
+    updateInactivity(player, result);
+    gameState.turn++;
+
+    gameState.diceRolled = false;
+    if (gameState.diceValue != 6 && result.capturedTokens == 0) {
+        if (Rules::Pass::enabled && allTokensHome(player)) {
+            // Pass the dice roll to a teammate if the current player has finished all their tokens
+            for (int teammate = 0; teammate < gameState.numPlayers; ++teammate) {
+                if (Rules::Teams::areTeammates(player, teammate) && !allTokensHome(teammate)) {
+                    gameState.currentPlayer = teammate;
+                    result.passedToTeammate = true;
+                    return result;
+                }
+            }
+        }
+        gameState.currentPlayer = (gameState.currentPlayer + 1) % gameState.numPlayers;
+    }
+
+    return result;
+}
+
+template <class Rules>
+MoveResult LudoEngine<Rules>::makeMove(int player, int tokenIndex, MoveUndo& undo)
+{
+    undo.player = static_cast<uint8_t>(player);
+    undo.tokenIndex = static_cast<uint8_t>(tokenIndex);
+    undo.currentPlayer = static_cast<uint8_t>(gameState.currentPlayer);
+    undo.diceValue = static_cast<uint8_t>(gameState.diceValue);
+    undo.diceRolled = gameState.diceRolled;
+    undo.wasKiller = gameState.killers[player];
+    undo.wasEliminated = gameState.eliminated[player];
+    undo.finishedPlayers = static_cast<int8_t>(gameState.finishedPlayers);
+    undo.eliminatedPlayers = static_cast<int8_t>(gameState.eliminatedPlayers);
+    undo.consecutiveTurnsWithoutProgress = gameState.consecutiveTurnsWithoutProgress[player];
+    undo.result = moveToken(player, tokenIndex);
+    return undo.result;
+}
+
+template <class Rules>
+void LudoEngine<Rules>::updateInactivity(int player, MoveResult& result)
+{
+    if (!Rules::Elimination::enabled) {
+        return;
+    }
+
+    // A turn counts as progress if the player rolled a 6 or has hit an opponent
+    if (gameState.diceValue == 6 || gameState.killers[player]) {
+        gameState.consecutiveTurnsWithoutProgress[player] = 0;
+    } else if (++gameState.consecutiveTurnsWithoutProgress[player] >= Rules::Elimination::limit) {
+        eliminatePlayer(player);
+        result.playerEliminated = true;
+    }
+}
+
+template <class Rules>
+bool LudoEngine<Rules>::shouldSkipTurn(int player)
+{
+    if (gameState.eliminated[player] || hasFinished(player)) {
+        return true;
+    }
+
+    if (!allTokensHome(player)) {
+        return false;
+    }
+
+    finishPlayer(player);
+    return true;
+}
+
+template <class Rules>
+bool LudoEngine<Rules>::gameIsOver() const
+{
+    // Players can also be eliminated from outside the engine, e.g. by turn timeouts
+    return gameState.numPlayers - gameState.finishedPlayers - gameState.eliminatedPlayers <= 1;
+}
+
+template <class Rules>
+void LudoEngine<Rules>::advanceTurn()
+{
+    gameState.currentPlayer = (gameState.currentPlayer + 1) % gameState.numPlayers;
+    gameState.diceRolled = false;
+}
+
+template <class Rules>
+bool LudoEngine<Rules>::playRandomTurn()
+{
+    if (gameIsOver()) {
+        return false;
+    }
+
+    int player = gameState.currentPlayer;
+    if (shouldSkipTurn(player)) {
+        advanceTurn();
+        return true;
+    }
+
+    rollDice();
+    moveToken(player, pickRandomToken(player, randomGenerator));
+    return true;
+}
+
+template <class Rules>
+int LudoEngine<Rules>::pickRandomToken(int player, mt19937& random) const
+{
+    uniform_int_distribution<> tokenDis(0, LudoBoard::MAX_TOKENS_PER_PLAYER - 1);
+    int tokenIndex;
+    do {
+        tokenIndex = tokenDis(random);
+    } while (gameState.finished[player][tokenIndex]);
+    return tokenIndex;
+}
+
+template <class Rules>
+int LudoEngine<Rules>::playRandomGame(int maxTurns)
+{
+    return playObservedGame(maxTurns, [](int, const MoveResult&) {});
+}
+
+template <class Rules>
+template <class Observer>
+int LudoEngine<Rules>::playObservedGame(int maxTurns, Observer&& observe)
+{
+    // Same sequence as repeated playRandomTurn calls
+    while (gameState.turn < maxTurns && !gameIsOver()) {
+        int player = gameState.currentPlayer;
+        if (shouldSkipTurn(player)) {
+            advanceTurn();
+            continue;
+        }
+
+        rollDice();
+        MoveResult result = moveToken(player, pickRandomToken(player, randomGenerator));
+        observe(player, result);
+    }
+
+    return gameState.turn;
+}
+
+template <class Yes, class No, class Visitor>
+void selectPolicy(bool useYes, Visitor&& visitor)
+{
+    if (useYes) {
+        visitor(Yes());
+    } else {
+        visitor(No());
+    }
+}
+
+template <class Visitor>
+void dispatchRules(const RulesConfig& config, Visitor&& visitor)
+{
+    selectPolicy<PairedTeams, ClassicTeams>(config.teamMode, [&](auto teams) {
+        selectPolicy<KillerRule, NoKillerRule>(config.killerRule, [&](auto killer) {
+            selectPolicy<Blockades, NoBlockades>(config.blockades, [&](auto blockade) {
+                selectPolicy<PassToTeammate, NoTurnPassing>(config.teamMode && config.teammatePassing, [&](auto pass) {
+                    selectPolicy<InactivityElimination<20>, NoElimination>(config.inactivityElimination, [&](auto elimination) {
+                        visitor(RuleSet<decltype(teams), decltype(killer), decltype(blockade),
+                                        decltype(pass), decltype(elimination)>());
+                    });
+                });
+            });
+        });
+    });
+}
+
+unique_ptr<RulesEngine> makeRulesEngine(const RulesConfig& config, uint32_t seed)
+{
+    unique_ptr<RulesEngine> engine;
+    dispatchRules(config, [&](auto rules) {
+        engine.reset(new LudoEngine<decltype(rules)>());
+    });
+    engine->reset(config.numPlayers, seed);
+    return engine;
+}
@@ -0,0 +1,267 @@
+#ifndef LUDO_ENGINE_HPP
+#define LUDO_ENGINE_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <algorithm>
+
+using namespace std;
+
+// Colour of a board cell as drawn by drawBoard
+enum CellKind {
+    CELL_WHITE,
+    CELL_RED,
+    CELL_GREEN,
+    CELL_BLUE,
+    CELL_YELLOW,
+    CELL_BLACK,
+    CELL_GREY
+};
+
+// Board layout shared by every front-end. Cells are packed as row * BOARD_SIZE + column
+// so a token position fits in a byte and per-cell tables can be plain arrays.
+struct LudoBoard {
+    static const int BOARD_SIZE = 15;
+    static const int CELL_COUNT = BOARD_SIZE * BOARD_SIZE;
+    static const int MAX_TOKENS_PER_PLAYER = 4;
+    static const int MAX_PLAYERS = 4;
+    static const int LUDO_PATH_LENGTH = 52;
+    static const int KILLER_PATH_LENGTH = 57;
+    static const int START_OFFSET = 13;
+
+    uint8_t ludoPath[LUDO_PATH_LENGTH];
+    uint8_t killersPath[MAX_PLAYERS][KILLER_PATH_LENGTH];
+    uint8_t playerStartPositions[MAX_PLAYERS * MAX_TOKENS_PER_PLAYER];
+    uint8_t safeZones[8];
+
+    // Index of every cell on each path. Cells that are not on the path map to the
+    // nearest path cell, which is what the original linear search fell back to.
+    uint8_t ludoPathIndex[CELL_COUNT];
+    uint8_t killersPathIndex[MAX_PLAYERS][CELL_COUNT];
+    bool safeZone[CELL_COUNT];
+    int8_t yardOwner[CELL_COUNT];
+
+    static const LudoBoard& get();
+    static CellKind cellKind(int row, int column);
+    static CellKind playerCellKind(int player) { return static_cast<CellKind>(CELL_RED + player); }
+
+    static uint8_t cell(int row, int column) { return static_cast<uint8_t>(row * BOARD_SIZE + column); }
+    static int row(uint8_t cell) { return cell / BOARD_SIZE; }
+    static int column(uint8_t cell) { return cell % BOARD_SIZE; }
+
+private:
+    LudoBoard();
+};
+
+// Complete per-game state. Fixed-size so an engine can be reset and reused between games.
+struct GameState {
+    uint8_t tokens[LudoBoard::MAX_PLAYERS][LudoBoard::MAX_TOKENS_PER_PLAYER];
+    // Per-cell token counts, one 4-bit field per player (bits 4p..4p+3), kept in step
+    // with tokens by placeToken so stack, blockade and capture checks are bit operations
+    uint16_t occupancy[LudoBoard::CELL_COUNT];
+    bool finished[LudoBoard::MAX_PLAYERS][LudoBoard::MAX_TOKENS_PER_PLAYER];
+    bool killers[LudoBoard::MAX_PLAYERS];
+    bool eliminated[LudoBoard::MAX_PLAYERS];
+    int consecutiveTurnsWithoutProgress[LudoBoard::MAX_PLAYERS];
+    int finishingOrder[LudoBoard::MAX_PLAYERS];
+    int finishedPlayers;
+    int eliminatedPlayers;
+    int numPlayers;
+    int currentPlayer;
+    int diceValue;
+    bool diceRolled;
+    int turn;
+};
+
+struct MoveResult {
+    uint8_t from;
+    uint8_t to;
+    uint16_t capturedTokens;    // bit (player * MAX_TOKENS_PER_PLAYER + token) per captured token
+    bool tokenFinished;
+    bool playerFinished;
+    bool passedToTeammate;
+    bool playerEliminated;
+};
+
+// What makeMove changed beyond its MoveResult, enough for unmakeMove to restore the
+// state exactly without copying it
+struct MoveUndo {
+    MoveResult result;
+    uint8_t player;
+    uint8_t tokenIndex;
+    uint8_t currentPlayer;
+    uint8_t diceValue;
+    bool diceRolled;
+    bool wasKiller;
+    bool wasEliminated;
+    int8_t finishedPlayers;
+    int8_t eliminatedPlayers;
+    int consecutiveTurnsWithoutProgress;
+};
+
+// Rule policies. Each variant is a pair of empty structs so RuleSet can be composed
+// at compile time and the unused branches disappear from the specialised engine.
+struct ClassicTeams {
+    static const bool enabled = false;
+    static bool areTeammates(int, int) { return false; }
+};
+
+struct PairedTeams {
+    static const bool enabled = true;
+    static bool areTeammates(int player1, int player2) { return player1 % 2 == player2 % 2; }
+};
+
+// Tokens only enter the home column after their player has captured a token.
+struct KillerRule {
+    static const bool enabled = true;
+};
+
+// Every player uses its home path from the start; captures are not required to finish.
+struct NoKillerRule {
+    static const bool enabled = false;
+};
+
+struct Blockades {
+    static const bool enabled = true;
+};
+
+struct NoBlockades {
+    static const bool enabled = false;
+};
+
+struct PassToTeammate {
+    static const bool enabled = true;
+};
+
+struct NoTurnPassing {
+    static const bool enabled = false;
+};
+
+template <int TurnLimit>
+struct InactivityElimination {
+    static const bool enabled = true;
+    static const int limit = TurnLimit;
+};
+
+struct NoElimination {
+    static const bool enabled = false;
+    static const int limit = 0;
+};
+
+template <class TeamPolicy, class KillerPolicy, class BlockadePolicy, class PassPolicy, class EliminationPolicy>
+struct RuleSet {
+    typedef TeamPolicy Teams;
+    typedef KillerPolicy Killer;
+    typedef BlockadePolicy Blockade;
+    typedef PassPolicy Pass;
+    typedef EliminationPolicy Elimination;
+};
+
+typedef RuleSet<ClassicTeams, KillerRule, Blockades, NoTurnPassing, InactivityElimination<20>> ClassicRules;
+typedef RuleSet<PairedTeams, KillerRule, Blockades, PassToTeammate, InactivityElimination<20>> TeamRules;
+
+// Runtime description of a rule set, mapped onto a RuleSet instantiation by dispatchRules.
+struct RulesConfig {
+    int numPlayers = 4;
+    bool teamMode = false;
+    bool killerRule = true;
+    bool blockades = true;
+    bool teammatePassing = true;
+    bool inactivityElimination = true;
+};
+
+// Type-erased view of an engine for front-ends that pick the rules at startup.
+class RulesEngine {
+public:
+    virtual ~RulesEngine() {}
+
+    GameState& state() { return gameState; }
+    const GameState& state() const { return gameState; }
+    // The dice generator, for callers that replay playRandomTurn's sequence step by step
+    mt19937& randomEngine() { return randomGenerator; }
+
+    virtual void reset(int numPlayers, uint32_t seed) = 0;
+    virtual int rollDice() = 0;
+    virtual MoveResult moveToken(int player, int tokenIndex) = 0;
+    // moveToken that also fills undo; unmakeMove(undo) reverts it in constant time.
+    // Moves must be unmade in the reverse order they were made.
+    virtual MoveResult makeMove(int player, int tokenIndex, MoveUndo& undo) = 0;
+    void unmakeMove(const MoveUndo& undo);
+    virtual bool shouldSkipTurn(int player) = 0;
+    virtual bool gameIsOver() const = 0;
+    virtual bool areTeammates(int player1, int player2) const = 0;
+    // Bit per token of player that the current dice value actually moves
+    virtual int legalMoves(int player) const = 0;
+    virtual bool playRandomTurn() = 0;
+    virtual int playRandomGame(int maxTurns) = 0;
+
+    bool isTokenInYard(uint8_t token, int player) const { return LudoBoard::get().yardOwner[token] == player; }
+    bool isSafeZone(uint8_t position) const { return LudoBoard::get().safeZone[position]; }
+    bool allTokensHome(int player) const;
+    bool hasFinished(int player) const;
+    void finishPlayer(int player);
+    void eliminatePlayer(int player);
+
+    int tokenCountAt(int player, uint8_t position) const {
+        return (gameState.occupancy[position] >> (4 * player)) & 0xF;
+    }
+    // The only way token positions should change, so occupancy stays in step
+    void placeToken(int player, int tokenIndex, uint8_t position) {
+        uint8_t& token = gameState.tokens[player][tokenIndex];
+        gameState.occupancy[token] -= 1 << (4 * player);
+        gameState.occupancy[position] += 1 << (4 * player);
+        token = position;
+    }
+
+protected:
+    GameState gameState;
+    mt19937 randomGenerator;
+};
+
+template <class Rules>
+class LudoEngine final : public RulesEngine {
+public:
+    LudoEngine() { reset(LudoBoard::MAX_PLAYERS, 0); }
+
+    void reset(int numPlayers, uint32_t seed) override;
+    int rollDice() override;
+    MoveResult moveToken(int player, int tokenIndex) override;
+    MoveResult makeMove(int player, int tokenIndex, MoveUndo& undo) override;
+    bool shouldSkipTurn(int player) override;
+    bool gameIsOver() const override;
+    bool areTeammates(int player1, int player2) const override { return Rules::Teams::areTeammates(player1, player2); }
+    bool playRandomTurn() override;
+    int playRandomGame(int maxTurns) override;
+
+    uint8_t moveTokenOnBoard(uint8_t token, int player, int tokenIndex);
+    // Where a token on the board goes with the current dice value; sets finishes instead
+    // when it would run off the end of its home path
+    uint8_t destination(uint8_t token, int player, bool& finishes) const;
+    int legalMoves(int player) const override;
+    void advanceTurn();
+    int pickRandomToken(int player, mt19937& random) const;
+
+    // playRandomGame with observe(player, result) called after every move
+    template <class Observer>
+    int playObservedGame(int maxTurns, Observer&& observe);
+
+private:
+    // Occupancy fields of the player plus teammates, and of the players it can capture
+    uint16_t friendlyMask[LudoBoard::MAX_PLAYERS];
+    uint16_t opponentMask[LudoBoard::MAX_PLAYERS];
+
+    bool canLandOn(uint8_t position, int player) const;
+    void updateInactivity(int player, MoveResult& result);
+};
+
+// Calls visitor(RuleSet<...>()) with the instantiation matching the runtime config.
+template <class Visitor>
+void dispatchRules(const RulesConfig& config, Visitor&& visitor);
+
+unique_ptr<RulesEngine> makeRulesEngine(const RulesConfig& config, uint32_t seed);
+
+#endif // LUDO_ENGINE_HPP
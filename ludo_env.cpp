@@ -0,0 +1,3 @@
+// Shared library for the RL environment C API, see ludo_env.hpp
+#include "ludo_engine.h"
+#include "ludo_env.h"
@@ -0,0 +1,282 @@
+#include "ludo_env.hpp"
+
+template <class Rules>
+VectorEnvironment<Rules>::VectorEnvironment(const LudoEnvConfig& envConfig, int numEnvs)
+    : config(envConfig),
+      engines(numEnvs),
+      nextSeed(numEnvs),
+      legal(numEnvs)
+{
+}
+
+template <class Rules>
+void VectorEnvironment<Rules>::reset()
+{
+    for (size_t env = 0; env < engines.size(); ++env) {
+        nextSeed[env] = config.seed + env;
+        startGame(static_cast<int>(env));
+        buffers.rewards[env] = 0;
+        buffers.dones[env] = 0;
+        writeObservation(static_cast<int>(env));
+    }
+}
+
+template <class Rules>
+void VectorEnvironment<Rules>::startGame(int env)
+{
+    // Inactivity elimination can end a game before anyone has a token to move;
+    // such seeds are skipped so every episode starts on a decision
+    do {
+        engines[env].reset(config.numPlayers, static_cast<uint32_t>(nextSeed[env]));
+        nextSeed[env] += engines.size();
+    } while (!advanceToDecision(env));
+}
+
+template <class Rules>
+bool VectorEnvironment<Rules>::advanceToDecision(int env)
+{
+    LudoEngine<Rules>& engine = engines[env];
+    GameState& state = engine.state();
+
+    while (!engine.gameIsOver() && state.turn < config.maxTurns) {
+        int player = state.currentPlayer;
+        if (engine.shouldSkipTurn(player)) {
+            engine.advanceTurn();
+            continue;
+        }
+
+        engine.rollDice();
+        legal[env] = engine.legalMoves(player);
+        if (legal[env] != 0) {
+            return true;
+        }
+
+        // Nothing can move: play the turn out as the GUI would, so inactivity still counts
+        int token = 0;
+        while (state.finished[player][token]) {
+            token++;
+        }
+        engine.moveToken(player, token);
+    }
+
+    legal[env] = 0;
+    return false;
+}
+
+// The player's side has taken first place: everyone who has finished is on it and
+// every teammate still able to finish has done so. Without teams the side is the player.
+template <class Rules>
+bool VectorEnvironment<Rules>::sideWon(int env, int player) const
+{
+    const LudoEngine<Rules>& engine = engines[env];
+    const GameState& state = engine.state();
+
+    for (int i = 0; i < state.finishedPlayers; ++i) {
+        int finisher = state.finishingOrder[i];
+        if (finisher != player && !Rules::Teams::areTeammates(player, finisher)) {
+            return false;
+        }
+    }
+    for (int teammate = 0; teammate < state.numPlayers; ++teammate) {
+        if (Rules::Teams::areTeammates(player, teammate) && !state.eliminated[teammate] && !engine.hasFinished(teammate)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class Rules>
+void VectorEnvironment<Rules>::step(const int32_t* actions)
+{
+    for (size_t i = 0; i < engines.size(); ++i) {
+        int env = static_cast<int>(i);
+        LudoEngine<Rules>& engine = engines[env];
+        const GameState& state = engine.state();
+        int player = state.currentPlayer;
+
+        int action = actions[env];
+        if (action < 0 || action >= LUDO_ENV_ACTIONS || !(legal[env] & (1 << action))) {
+            action = __builtin_ctz(legal[env]);
+        }
+
+        MoveResult result = engine.moveToken(player, action);
+
+        bool won = result.playerFinished && sideWon(env, player);
+        buffers.rewards[env] = won ? 1.0f : 0.0f;
+        buffers.dones[env] = !advanceToDecision(env);
+        if (buffers.dones[env]) {
+            startGame(env);
+        }
+        writeObservation(env);
+    }
+}
+
+template <class Rules>
+void VectorEnvironment<Rules>::writeObservation(int env)
+{
+    const LudoBoard& board = LudoBoard::get();
+    const LudoEngine<Rules>& engine = engines[env];
+    const GameState& state = engine.state();
+    int player = state.currentPlayer;
+
+    float* out = buffers.observations + static_cast<size_t>(env) * LUDO_ENV_OBSERVATION_SIZE;
+    float* seatFlags = out + 70;
+    fill(out, out + LUDO_ENV_OBSERVATION_SIZE, 0.0f);
+
+    for (int seat = 0; seat < LudoBoard::MAX_PLAYERS; ++seat) {
+        int other = (player + seat) % LudoBoard::MAX_PLAYERS;
+        if (other >= state.numPlayers) continue;
+
+        for (int token = 0; token < LudoBoard::MAX_TOKENS_PER_PLAYER; ++token) {
+            float* features = out + (seat * LudoBoard::MAX_TOKENS_PER_PLAYER + token) * 4;
+            uint8_t cell = state.tokens[other][token];
+
+            if (state.finished[other][token]) {
+                features[0] = 1.0f;
+                features[2] = 1.0f;
+            } else if (engine.isTokenInYard(cell, other)) {
+                features[1] = 1.0f;
+            } else {
+                features[0] = static_cast<float>(board.killersPathIndex[other][cell] + 1) / LudoBoard::KILLER_PATH_LENGTH;
+                features[3] = engine.isSafeZone(cell) ? 1.0f : 0.0f;
+            }
+        }
+
+        seatFlags[seat * 3] = state.killers[other];
+        seatFlags[seat * 3 + 1] = !state.eliminated[other] && !engine.hasFinished(other);
+        seatFlags[seat * 3 + 2] = seat != 0 && Rules::Teams::areTeammates(player, other);
+    }
+
+    out[64 + state.diceValue - 1] = 1.0f;
+
+    uint8_t* mask = buffers.legalMasks + static_cast<size_t>(env) * LUDO_ENV_ACTIONS;
+    for (int token = 0; token < LUDO_ENV_ACTIONS; ++token) {
+        mask[token] = (legal[env] >> token) & 1;
+    }
+    if (buffers.players) {
+        buffers.players[env] = player;
+    }
+}
+
+extern "C" {
+
+LudoVecEnv* ludo_env_create(const LudoEnvConfig* config, int32_t numEnvs)
+{
+    if (!config || numEnvs <= 0 || config->maxTurns <= 0 ||
+        config->numPlayers < 2 || config->numPlayers > LudoBoard::MAX_PLAYERS ||
+        (config->teamMode && config->numPlayers != LudoBoard::MAX_PLAYERS)) {
+        return nullptr;
+    }
+
+    RulesConfig rules;
+    rules.numPlayers = config->numPlayers;
+    rules.teamMode = config->teamMode;
+    rules.killerRule = config->killerRule;
+    rules.blockades = config->blockades;
+    rules.inactivityElimination = config->inactivityElimination;
+
+    LudoVecEnv* env = nullptr;
+    dispatchRules(rules, [&](auto ruleSet) {
+        env = new VectorEnvironment<decltype(ruleSet)>(*config, numEnvs);
+    });
+    return env;
+}
+
+void ludo_env_destroy(LudoVecEnv* env)
+{
+    delete env;
+}
+
+void ludo_env_bind(LudoVecEnv* env, const LudoEnvBuffers* buffers)
+{
+    env->buffers = *buffers;
+}
+
+void ludo_env_reset(LudoVecEnv* env)
+{
+    env->reset();
+}
+
+void ludo_env_step(LudoVecEnv* env, const int32_t* actions)
+{
+    env->step(actions);
+}
+
+}
+
+int checkEnvironment(const LudoEnvConfig& config, int numEnvs, int steps)
+{
+    LudoVecEnv* env = ludo_env_create(&config, numEnvs);
+    if (!env) {
+        throw runtime_error("Invalid environment configuration.");
+    }
+
+    vector<float> observations(static_cast<size_t>(numEnvs) * LUDO_ENV_OBSERVATION_SIZE);
+    vector<float> rewards(numEnvs);
+    vector<uint8_t> dones(numEnvs);
+    vector<uint8_t> masks(static_cast<size_t>(numEnvs) * LUDO_ENV_ACTIONS);
+    vector<int32_t> actions(numEnvs);
+    LudoEnvBuffers buffers = {observations.data(), rewards.data(), dones.data(), masks.data(), nullptr};
+    ludo_env_bind(env, &buffers);
+    ludo_env_reset(env);
+
+    // Every environment must offer at least one legal token after reset and after every step
+    mt19937 random(static_cast<uint32_t>(config.seed));
+    int failures = 0;
+    for (int step = 0; step <= steps; ++step) {
+        for (int i = 0; i < numEnvs; ++i) {
+            const uint8_t* mask = &masks[static_cast<size_t>(i) * LUDO_ENV_ACTIONS];
+            if (count(mask, mask + LUDO_ENV_ACTIONS, 1) == 0) {
+                failures++;
+            }
+            actions[i] = static_cast<int32_t>(random() % LUDO_ENV_ACTIONS);
+        }
+        if (step < steps) {
+            ludo_env_step(env, actions.data());
+        }
+    }
+
+    ludo_env_destroy(env);
+    return failures;
+}
+
+void benchmarkEnvironment(const LudoEnvConfig& config, int numEnvs)
+{
+    LudoVecEnv* env = ludo_env_create(&config, numEnvs);
+    if (!env) {
+        throw runtime_error("Invalid environment configuration.");
+    }
+
+    vector<float> observations(static_cast<size_t>(numEnvs) * LUDO_ENV_OBSERVATION_SIZE);
+    vector<float> rewards(numEnvs);
+    vector<uint8_t> dones(numEnvs);
+    vector<uint8_t> masks(static_cast<size_t>(numEnvs) * LUDO_ENV_ACTIONS);
+    vector<int32_t> actions(numEnvs);
+    LudoEnvBuffers buffers = {observations.data(), rewards.data(), dones.data(), masks.data(), nullptr};
+    ludo_env_bind(env, &buffers);
+    ludo_env_reset(env);
+
+    mt19937 random(static_cast<uint32_t>(config.seed));
+    const int steps = 2000;
+    long long episodes = 0;
+    double totalReward = 0;
+    auto start = chrono::steady_clock::now();
+
+    for (int step = 0; step < steps; ++step) {
+        for (int i = 0; i < numEnvs; ++i) {
+            actions[i] = static_cast<int32_t>(random() % LUDO_ENV_ACTIONS);
+        }
+        ludo_env_step(env, actions.data());
+        for (int i = 0; i < numEnvs; ++i) {
+            episodes += dones[i];
+            totalReward += rewards[i];
+        }
+    }
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long long totalSteps = static_cast<long long>(steps) * numEnvs;
+    cout << "Steps: " << totalSteps << " over " << numEnvs << " environments in " << seconds << " s ("
+         << static_cast<long long>(totalSteps / max(seconds, 1e-9)) << " steps/s)" << endl;
+    cout << "Episodes: " << episodes << " | wins rewarded: " << totalReward << endl;
+    ludo_env_destroy(env);
+}
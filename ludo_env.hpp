@@ -0,0 +1,103 @@
+#ifndef LUDO_ENV_HPP
+#define LUDO_ENV_HPP
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include <iostream>
+#include "ludo_engine.hpp"
+
+using namespace std;
+
+// Vectorised environment for reinforcement learning, as a C API so Python (ctypes,
+// cffi, numpy) can drive it without copies. Build the shared library with
+//   g++ -std=c++17 -O2 -shared -fPIC -o libludo_env.so ludo_env.cpp -pthread
+//
+// One call steps every game. Every game waits at a decision point: the dice are
+// rolled for the player to move and at least one token can move. Games whose roll
+// moves nothing are played on automatically. A finished game sets its done flag and
+// is reset in the same step, so the observation is already the new game's first one.
+extern "C" {
+
+enum {
+    LUDO_ENV_ACTIONS = 4,           // token index 0..3
+    LUDO_ENV_OBSERVATION_SIZE = 82
+};
+
+struct LudoEnvConfig {
+    int32_t numPlayers;             // 2..4, 4 in team mode
+    int32_t teamMode;
+    int32_t killerRule;
+    int32_t blockades;
+    int32_t inactivityElimination;
+    int32_t maxTurns;               // longer games end with done and no reward
+    uint64_t seed;                  // game g of env i uses seed + i + g * numEnvs
+};
+
+// Caller-owned, contiguous, row-major over environments
+struct LudoEnvBuffers {
+    float* observations;            // numEnvs * LUDO_ENV_OBSERVATION_SIZE
+    float* rewards;                 // numEnvs, 1 when the move just made won the game for the
+                                    // acting player's side (their team in team mode)
+    uint8_t* dones;                 // numEnvs
+    uint8_t* legalMasks;            // numEnvs * LUDO_ENV_ACTIONS, 1 where the token can move
+    int32_t* players;               // numEnvs, seat to act next; may be null
+};
+
+typedef struct LudoVecEnv LudoVecEnv;
+
+// Returns null when the config is invalid
+LudoVecEnv* ludo_env_create(const LudoEnvConfig* config, int32_t numEnvs);
+void ludo_env_destroy(LudoVecEnv* env);
+
+// Buffers stay bound until the next bind; reset and step write into them
+void ludo_env_bind(LudoVecEnv* env, const LudoEnvBuffers* buffers);
+void ludo_env_reset(LudoVecEnv* env);
+
+// actions: numEnvs token indices. An illegal action plays the lowest legal token.
+void ludo_env_step(LudoVecEnv* env, const int32_t* actions);
+
+}
+
+// Observation layout, relative to the player to act (seat 0 = that player):
+//   [0, 64)   per seat, per token: path progress 0..1, in yard, finished, on a safe zone
+//   [64, 70)  dice value, one-hot
+//   [70, 82)  per seat: has captured (killer), still playing, teammate
+struct LudoVecEnv {
+    virtual ~LudoVecEnv() {}
+    virtual void reset() = 0;
+    virtual void step(const int32_t* actions) = 0;
+
+    LudoEnvBuffers buffers = {};
+};
+
+template <class Rules>
+class VectorEnvironment final : public LudoVecEnv {
+public:
+    VectorEnvironment(const LudoEnvConfig& config, int numEnvs);
+
+    void reset() override;
+    void step(const int32_t* actions) override;
+
+private:
+    LudoEnvConfig config;
+    vector<LudoEngine<Rules>> engines;
+    vector<uint64_t> nextSeed;
+    vector<int> legal;              // legalMoves of the player to act
+
+    void startGame(int env);
+    bool advanceToDecision(int env);
+    bool sideWon(int env, int player) const;
+    void writeObservation(int env);
+};
+
+// Steps numEnvs environments with random actions and reports steps/s
+void benchmarkEnvironment(const LudoEnvConfig& config, int numEnvs);
+
+// Steps numEnvs environments with random actions and counts the observations that
+// came with an empty legal mask, which should never happen
+int checkEnvironment(const LudoEnvConfig& config, int numEnvs, int steps);
+
+#endif // LUDO_ENV_HPP
@@ -1,13 +1,5 @@
 #include "ludo_game.hpp"
 
-struct ThreadParams {
-    int player;
-    int row;
-    int column;
-    int hit_record;
-    LudoGame* game;
-};
-
 void* LudoGame::playerThread(void* arg) {
     ThreadParams* params = static_cast<ThreadParams*>(arg);
     LudoGame* game = params->game;
@@ -16,13 +8,13 @@ void* LudoGame::playerThread(void* arg) {
         sem_wait(&game->semaphore);
 
         unique_lock<mutex> lock(game->gameMutex);
-        game->cv.wait(lock, [&game, &params] { return game->shouldSkipTurn(params->player) || game->diceRolled; });
+        game->cv.wait(lock, [&game, &params] { return game->shouldSkipTurn(params->player) || game->rules->state().diceRolled; });
 
         if (game->shouldSkipTurn(params->player)) {
             continue;
         }
 
-        if (!game->diceRolled) {
+        if (!game->rules->state().diceRolled) {
             continue;
         }
 
@@ -36,49 +28,24 @@ void* LudoGame::playerThread(void* arg) {
     return nullptr;
 }
 
-void* LudoGame::gameThread(void* arg) {
-    int player = *static_cast<int*>(arg);
-    LudoGame* game = static_cast<LudoGame*>(arg);
-
-    while (true) {
-        // Lock the game state
-        std::unique_lock<std::mutex> lock(game->gameMutex);
-
-        if (game->playerMadeProgress(player)) {
-            game->consecutiveTurnsWithoutProgress[player] = 0;
-        } else {
-            game->consecutiveTurnsWithoutProgress[player]++;
-            if (game->consecutiveTurnsWithoutProgress[player] >= 20) {
-                // Cancel this player's thread
-                pthread_cancel(game->playerThreads[player]);
-                game->removePlayer(player);
-                break;
-            }
-        }
-
-        if (game->allTokensHome(player)) {
-            // Player has finished
-            game->finishPlayer(player);
-            pthread_cancel(game->playerThreads[player]);
-            break;
-        }
-    }
-
-    return nullptr;
-}
-
 void* LudoGame::rowColumnThread(void* arg) {
     ThreadParams* params = static_cast<ThreadParams*>(arg);
     LudoGame* game = params->game;
 
     while (true) {
-        for (int player = 0; player < game->numPlayers; ++player) {
-            for (int token = 0; token < MAX_TOKENS_PER_PLAYER; ++token) {
-                game->checkForHits(player, token);
+        bool over;
+        {
+            // Read-only sweep, under the lock so it never sees a move half applied
+            lock_guard<mutex> lock(game->gameMutex);
+            for (int player = 0; player < game->numPlayers; ++player) {
+                for (int token = 0; token < MAX_TOKENS_PER_PLAYER; ++token) {
+                    game->checkForHits(player, token);
+                }
             }
+            over = game->gameIsOver();
         }
 
-        if (game->gameIsOver()) {
+        if (over) {
             break;
         }
 
@@ -106,23 +73,48 @@ void* LudoGame::masterThread(void* arg) {
         if (game->gameIsOver()) {
             break;
         }
+
+        // Let the logic thread and frame snapshots get at the state between checks
+        lock.unlock();
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+
+    return nullptr;
+}
+
+void* LudoGame::logicThread(void* arg) {
+    LudoGame* game = static_cast<LudoGame*>(arg);
+    InputEvent event;
+
+    while (true) {
+        sem_wait(&game->inputReady);
+        if (!game->inputQueue.pop(event)) {
+            continue;
+        }
+        if (event.type == INPUT_QUIT) {
+            break;
+        }
+
+        lock_guard<mutex> lock(game->gameMutex);
+        game->applyInput(event);
     }
 
     return nullptr;
 }
 
 void LudoGame::initializeThreads() {
+    // Parameters live in the game object so they are released with it
     for (int i = 0; i < numPlayers; ++i) {
-        ThreadParams* params = new ThreadParams{i, 0, 0, 0, this};
-        pthread_create(&playerThreads[i], nullptr, LudoGame::playerThread, params); // Use LudoGame::playerThread
+        playerThreadParams[i] = ThreadParams{i, 0, 0, 0, this};
+        pthread_create(&playerThreads[i], nullptr, LudoGame::playerThread, &playerThreadParams[i]); // Use LudoGame::playerThread
     }
 
     for (int i = 0; i < GRID_SIZE; ++i) {
-        ThreadParams* rowParams = new ThreadParams{0, i, 0, 0, this};
-        pthread_create(&rowColumnThreads[i], nullptr, LudoGame::rowColumnThread, rowParams); // Use LudoGame::rowColumnThread
+        rowColumnThreadParams[i] = ThreadParams{0, i, 0, 0, this};
+        pthread_create(&rowColumnThreads[i], nullptr, LudoGame::rowColumnThread, &rowColumnThreadParams[i]); // Use LudoGame::rowColumnThread
         
-        ThreadParams* colParams = new ThreadParams{0, 0, i, 0, this};
-        pthread_create(&rowColumnThreads[GRID_SIZE + i], nullptr, LudoGame::rowColumnThread, colParams); // Use LudoGame::rowColumnThread
+        rowColumnThreadParams[GRID_SIZE + i] = ThreadParams{0, 0, i, 0, this};
+        pthread_create(&rowColumnThreads[GRID_SIZE + i], nullptr, LudoGame::rowColumnThread, &rowColumnThreadParams[GRID_SIZE + i]); // Use LudoGame::rowColumnThread
     }
 
     pthread_create(&masterThreadHandle, nullptr, LudoGame::masterThread, this); // Use LudoGame::masterThread
@@ -130,9 +122,18 @@ void LudoGame::initializeThreads() {
 
 LudoGame::LudoGame()
     : window(sf::VideoMode(GRID_SIZE * TILE_SIZE, GRID_SIZE * TILE_SIZE), "Ludo Game"),
-      currentPlayer(0),
-      diceValue(0),
-      diceRolled(false)
+      teamMode(false),
+      numPlayers(0),
+      simulationMode(false),
+      lastInfoKey(-1),
+      armedTurnKey(-1),
+      timedOutTurns{},
+      inputSequence(0),
+      appliedInputSequence(0),
+      renderedInputSequence(0),
+      measuredInputSequence(0),
+      lastLatencyCount(-1),
+      heatmapLayer(-1)
 {
     askNumberOfPlayers(window);
     initializeGame();
@@ -404,59 +405,17 @@ void LudoGame::askNumberOfPlayers(sf::RenderWindow& gameWindow)
 
 void LudoGame::initializeGame()
 {
-    playerColors = {
-        sf::Color::Red,
-        sf::Color::Green,
-        sf::Color::Blue,
-        sf::Color::Yellow
-    };
-
-    killers.resize(numPlayers, false);
-
-    playerStartPositions = {
-        {1, 1}, {1, 2}, {2, 1}, {2, 2}, // Red
-        {1, 12}, {1, 13}, {2, 12}, {2, 13}, // Green
-        {12, 12}, {12, 13}, {13, 12}, {13, 13}, // Yellow
-        {12, 1}, {12, 2}, {13, 1}, {13, 2} // Blue
-    };
-
-    ludoPath = {
-        {6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5}, {5, 6}, {4, 6}, {3, 6}, {2, 6}, {1, 6}, {0, 6}, {0, 7}, {0, 8}, {1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8}, {6, 9}, {6, 10}, {6, 11}, {6, 12}, {6, 13}, {6, 14}, {7, 14}, {8, 14}, {8, 13}, {8, 12}, {8, 11}, {8, 10}, {8, 9}, {9, 8}, {10, 8}, {11, 8}, {12, 8}, {13, 8}, {14, 8}, {14, 7}, {14, 6}, {13, 6}, {12, 6}, {11, 6}, {10, 6}, {9, 6}, {8, 5}, {8, 4}, {8, 3}, {8, 2}, {8, 1}, {8, 0}, {7, 0}, {6, 0}
-    };
-
-    vector<sf::Vector2i> killerRedLudoPath = {
-        {6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5}, {5, 6}, {4, 6}, {3, 6}, {2, 6}, {1, 6}, {0, 6}, {0, 7}, {0, 8}, {1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8}, {6, 9}, {6, 10}, {6, 11}, {6, 12}, {6, 13}, {6, 14}, {7, 14}, {8, 14}, {8, 13}, {8, 12}, {8, 11}, {8, 10}, {8, 9}, {9, 8}, {10, 8}, {11, 8}, {12, 8}, {13, 8}, {14, 8}, {14, 7}, {14, 6}, {13, 6}, {12, 6}, {11, 6}, {10, 6}, {9, 6}, {8, 5}, {8, 4}, {8, 3}, {8, 2}, {8, 1}, {8, 0}, {7, 0}, {7, 1}, {7, 2}, {7, 3}, {7, 4}, {7, 5}, {7, 6}
-    };
-
-    vector<sf::Vector2i> killerGreenLudoPath = {
-        {1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8}, {6, 9}, {6, 10}, {6, 11}, {6, 12}, {6, 13}, {6, 14}, {7, 14}, {8, 14}, {8, 13}, {8, 12}, {8, 11}, {8, 10}, {8, 9}, {9, 8}, {10, 8}, {11, 8}, {12, 8}, {13, 8}, {14, 8}, {14, 7}, {14, 6}, {13, 6}, {12, 6}, {11, 6}, {10, 6}, {9, 6}, {8, 5}, {8, 4}, {8, 3}, {8, 2}, {8, 1}, {8, 0}, {7, 0}, {6, 0}, {6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5}, {5, 6}, {4, 6}, {3, 6}, {2, 6}, {1, 6}, {0, 6}, {0, 7}, {1, 7}, {2, 7}, {3, 7}, {4, 7}, {5, 7}, {6, 7}
-    };
-
-    vector<sf::Vector2i> killerBlueLudoPath = {
-        {8, 13}, {8, 12}, {8, 11}, {8, 10}, {8, 9}, {9, 8}, {10, 8}, {11, 8}, {12, 8}, {13, 8}, {14, 8}, {14, 7}, {14, 6}, {13, 6}, {12, 6}, {11, 6}, {10, 6}, {9, 6}, {8, 5}, {8, 4}, {8, 3}, {8, 2}, {8, 1}, {8, 0}, {7, 0}, {6, 0}, {6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5}, {5, 6}, {4, 6}, {3, 6}, {2, 6}, {1, 6}, {0, 6}, {0, 7}, {0, 8}, {1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8}, {6, 9}, {6, 10}, {6, 11}, {6, 12}, {6, 13}, {6, 14}, {7, 14}, {7, 13}, {7, 12}, {7, 11}, {7, 10}, {7, 9}, {7, 8}
-    };
-
-    vector<sf::Vector2i> killerYellowLudoPath = {
-        {13, 6}, {12, 6}, {11, 6}, {10, 6}, {9, 6}, {8, 5}, {8, 4}, {8, 3}, {8, 2}, {8, 1}, {8, 0}, {7, 0}, {6, 0}, {6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5}, {5, 6}, {4, 6}, {3, 6}, {2, 6}, {1, 6}, {0, 6}, {0, 7}, {0, 8}, {1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8}, {6, 9}, {6, 10}, {6, 11}, {6, 12}, {6, 13}, {6, 14}, {7, 14}, {8, 14}, {8, 13}, {8, 12}, {8, 11}, {8, 10}, {8, 9}, {9, 8}, {10, 8}, {11, 8}, {12, 8}, {13, 8}, {14, 8}, {14, 7}, {13, 7}, {12, 7}, {11, 7}, {10, 7}, {9, 7}, {8, 7}
-    };
-
-    killersPath = {killerRedLudoPath, killerGreenLudoPath, killerBlueLudoPath, killerYellowLudoPath};
-
-    safeZones = {
-        {2, 6}, {6, 1}, {8, 2}, {13, 6}, {12, 8}, {8, 13}, {6, 12}, {1, 8}
-    };
-
-    playerTokens.resize(numPlayers);
-    for (int player = 0; player < numPlayers; ++player) {
-        for (int token = 0; token < MAX_TOKENS_PER_PLAYER; ++token) {
-            playerTokens[player].push_back(playerStartPositions[player * MAX_TOKENS_PER_PLAYER + token]);
-        }
+    for (int player = 0; player < MAX_PLAYERS; ++player) {
+        playerColors.push_back(playerColor(player));
     }
 
-    finishedPlayerTokens.resize(numPlayers);
-    for (int player = 0; player < numPlayers; ++player) {
-        finishedPlayerTokens[player].resize(MAX_TOKENS_PER_PLAYER, false);
-    }
+    // Board paths, safe zones and yards live in LudoBoard; the branches for the
+    // selected mode are resolved once here instead of on every move.
+    RulesConfig config;
+    config.numPlayers = numPlayers;
+    config.teamMode = teamMode;
+    config.inactivityElimination = false;
+    rules = makeRulesEngine(config, mt19937::default_seed);
 
     sf::ContextSettings settings;
     settings.antialiasingLevel = 8;
@@ -475,187 +434,135 @@ void LudoGame::initializeGame()
     infoText.setCharacterSize(10);
     infoText.setFillColor(sf::Color::Black);
     infoText.setPosition(10, GRID_SIZE * TILE_SIZE - 30);
+
+    turnDeadline.callback = LudoGame::onTurnTimeout;
+    turnDeadline.context = this;
+    timerStart = chrono::steady_clock::now();
 }
 
 int LudoGame::rollDice()
 {
-    uniform_int_distribution<> dis(1, 6);
-    return dis(randomGenerator);
+    return rules->rollDice();
 }
 
-bool LudoGame::playerMadeProgress(int player) {
-    // Check if the player rolled a 6 or hit an opponent
-    return (diceValue == 6 || killers[player]);
+sf::Vector2i LudoGame::tokenPosition(const GameState& state, int player, int tokenIndex)
+{
+    uint8_t cell = state.tokens[player][tokenIndex];
+    return sf::Vector2i(LudoBoard::row(cell), LudoBoard::column(cell));
 }
 
 void LudoGame::removePlayer(int player) {
     // Remove the player from the game
     // This could involve setting a flag, removing their tokens, etc.
-    cout << "Player " << player + 1 << " has been eliminated." << endl;
+    logEvent(LOG_INFO, EVENT_ELIMINATION, player);
 }
 
 bool LudoGame::allTokensHome(int player) {
-    return all_of(finishedPlayerTokens[player].begin(), 
-                  finishedPlayerTokens[player].end(), 
-                  [](bool finished) { return finished; });
+    return rules->allTokensHome(player);
 }
 
 void LudoGame::finishPlayer(int player) {
-    finishingOrder.push_back(player);
+    rules->finishPlayer(player);
 }
 
 bool LudoGame::gameIsOver() {
-    return finishingOrder.size() >= numPlayers - 1;
+    return rules->gameIsOver();
 }
 
+// Caller holds gameMutex. The engine captures as a token lands, so this only reports
+// an opponent left on the token's cell that moveToken should have sent home.
 void LudoGame::checkForHits(int player, int tokenIndex) {
-    sf::Vector2i tokenPosition = playerTokens[player][tokenIndex];
+    const GameState& state = rules->state();
+    uint8_t tokenPosition = state.tokens[player][tokenIndex];
+
+    // Nothing but this player's own tokens on the cell, or a cell where tokens may share
+    const LudoBoard& board = LudoBoard::get();
+    if ((state.occupancy[tokenPosition] & ~(0xF << (4 * player))) == 0 || rules->isSafeZone(tokenPosition) ||
+        tokenPosition == board.ludoPath[LudoBoard::LUDO_PATH_LENGTH - 1] || state.finished[player][tokenIndex]) {
+        return;
+    }
 
     for (int otherPlayer = 0; otherPlayer < numPlayers; ++otherPlayer) {
-        if (otherPlayer == player) continue;
+        if (otherPlayer == player || areTeammates(player, otherPlayer) || rules->tokenCountAt(otherPlayer, tokenPosition) == 0) continue;
 
         for (int otherTokenIndex = 0; otherTokenIndex < MAX_TOKENS_PER_PLAYER; ++otherTokenIndex) {
-            sf::Vector2i otherTokenPosition = playerTokens[otherPlayer][otherTokenIndex];
-
-            if (tokenPosition == otherTokenPosition && !isSafeZone(tokenPosition)) {
-                // Hit detected, move the hit token back to its yard
-                playerTokens[otherPlayer][otherTokenIndex] = playerStartPositions[otherPlayer * MAX_TOKENS_PER_PLAYER + otherTokenIndex];
-                cout << "Player " << player + 1 << " hit Player " << otherPlayer + 1 << "'s token!" << endl;
+            if (state.tokens[otherPlayer][otherTokenIndex] == tokenPosition && !state.finished[otherPlayer][otherTokenIndex]) {
+                logEvent(LOG_WARN, EVENT_MISSED_CAPTURE, player, otherPlayer, otherTokenIndex, tokenPosition);
             }
         }
     }
 }
 
 bool LudoGame::areTeammates(int player1, int player2) {
-    if (!teamMode) return false;
-    return (player1 % 2 == player2 % 2);
-}
-
-sf::Vector2i LudoGame::moveTokenOnBoard(sf::Vector2i token, int player, int tokenIndex)
-{
-    const vector<sf::Vector2i>& path = killers[player] ? killersPath[player] : ludoPath;
-    
-    auto it = find(path.begin(), path.end(), token);
-    if (it == path.end()) {
-        it = min_element(path.begin(), path.end(), 
-            [&token](const sf::Vector2i& a, const sf::Vector2i& b) {
-                return (abs(a.x - token.x) + abs(a.y - token.y)) < 
-                       (abs(b.x - token.x) + abs(b.y - token.y));
-            });
-    }
-
-    size_t currentIndex = distance(path.begin(), it);
-    size_t newIndex = currentIndex + diceValue;
-
-    if (newIndex >= path.size()) {
-        if (killers[player]) {
-            finishedPlayerTokens[player][tokenIndex] = true;
-            return token;
-        } else {
-            newIndex = newIndex % path.size();
-        }
-    }
-
-    while (newIndex < path.size()) {
-        sf::Vector2i newPosition = path[newIndex];
-
-        int sameColorTokenCount = count(playerTokens[player].begin(), 
-                                             playerTokens[player].end(), 
-                                             newPosition);
-        
-        int teamBlockCount = 0;
-        int opposingBlockCount = 0;
-        for (int otherPlayer = 0; otherPlayer < numPlayers; ++otherPlayer) {
-            if (otherPlayer == player) continue;
-
-            int tokenCount = count(playerTokens[otherPlayer].begin(), 
-                                   playerTokens[otherPlayer].end(), 
-                                   newPosition);
-
-            if (areTeammates(player, otherPlayer)) {
-                teamBlockCount += tokenCount;
-            } else if (tokenCount >= 2) {
-                opposingBlockCount++;
-            }
-        }
-
-        if ((sameColorTokenCount + teamBlockCount <= 1 || isSafeZone(newPosition)) && 
-            (opposingBlockCount == 0 || isSafeZone(newPosition))) {
-            return newPosition;
-        }
-
-        newIndex++;
-    }
-
-    return token;
+    return rules->areTeammates(player1, player2);
 }
 
 void LudoGame::moveToken(int player, int tokenIndex)
 {
     lock_guard<mutex> lock(gameMutex);
+    applyMove(player, tokenIndex);
+}
 
-    auto& token = playerTokens[player][tokenIndex];
-    bool tokenCaptured = false;
+// Caller holds gameMutex
+void LudoGame::applyMove(int player, int tokenIndex)
+{
+    MoveUndo undo;
+    MoveResult result = rules->makeMove(player, tokenIndex, undo);
+    undoHistory.push_back(undo);
+    redoHistory.clear();
+    logMove(player, tokenIndex, result);
+}
 
-    if (isTokenInYard(token, player)) {
-        if (diceValue == 6) {
-            token = ludoPath[player * 13];
-        }
-    } else {
-        sf::Vector2i newPosition = moveTokenOnBoard(token, player, tokenIndex);
-        token = newPosition;
+// Logs a move the engine has just made, with the captures and elimination it caused
+void LudoGame::logMove(int player, int tokenIndex, const MoveResult& result)
+{
+    logEvent(LOG_DEBUG, EVENT_MOVE, player, -1, tokenIndex, result.to);
+    for (uint16_t captured = result.capturedTokens; captured != 0; captured &= captured - 1) {
+        int bit = __builtin_ctz(captured);
+        logEvent(LOG_INFO, EVENT_CAPTURE, player, bit / MAX_TOKENS_PER_PLAYER, bit % MAX_TOKENS_PER_PLAYER, result.to);
     }
-
-    for (int otherPlayer = 0; otherPlayer < numPlayers; ++otherPlayer) {
-        if (otherPlayer != player && !areTeammates(player, otherPlayer)) {
-            for (auto& otherToken : playerTokens[otherPlayer]) {
-                if (otherToken == token && !isSafeZone(token) && token != ludoPath.back()) {
-                    killers[player] = true;
-                    tokenCaptured = true;
-                    for (int i = 0; i < MAX_TOKENS_PER_PLAYER; ++i) {
-                        sf::Vector2i yardPosition = playerStartPositions[otherPlayer * MAX_TOKENS_PER_PLAYER + i];
-                        if (find(playerTokens[otherPlayer].begin(), playerTokens[otherPlayer].end(), yardPosition) == playerTokens[otherPlayer].end()) {
-                            otherToken = yardPosition;
-                            break;
-                        }
-                    }
-                }
-            }
-        }
+    if (result.playerEliminated) {
+        logEvent(LOG_INFO, EVENT_ELIMINATION, player);
     }
-
-    diceRolled = false;
-    if (diceValue != 6 && !tokenCaptured) {
-        if (allTokensHome(player)) {
-            // Pass the dice roll to a teammate if the current player has finished all their tokens
-            for (int teammate = 0; teammate < numPlayers; ++teammate) {
-                if (areTeammates(player, teammate) && !allTokensHome(teammate)) {
-                    currentPlayer = teammate;
-                    cout << "Player " << player + 1 << " has finished all their tokens. Passing the turn to Player " << currentPlayer + 1 << endl;
-                    return;
-                }
-            }
-        }
-        currentPlayer = (currentPlayer + 1) % numPlayers;
+    if (result.passedToTeammate) {
+        logEvent(LOG_INFO, EVENT_TURN_PASSED, player, rules->state().currentPlayer);
     }
 }
 
-bool LudoGame::isTokenInYard(const sf::Vector2i& token, int player)
+// Caller holds gameMutex. Puts the last mover back on their rolled dice so they can choose again.
+void LudoGame::undoMove()
 {
-    for (int i = 0; i < MAX_TOKENS_PER_PLAYER; ++i) {
-        if (token == playerStartPositions[player * MAX_TOKENS_PER_PLAYER + i]) {
-            return true;
-        }
+    if (undoHistory.empty()) {
+        return;
     }
-    return false;
+
+    rules->unmakeMove(undoHistory.back());
+    redoHistory.push_back(undoHistory.back());
+    undoHistory.pop_back();
 }
 
-bool LudoGame::isSafeZone(const sf::Vector2i& position)
+// Caller holds gameMutex. Replays the last undone move with the dice it was made with.
+void LudoGame::redoMove()
 {
-    return find(safeZones.begin(), safeZones.end(), position) != safeZones.end();
+    if (redoHistory.empty()) {
+        return;
+    }
+
+    const MoveUndo& redo = redoHistory.back();
+    GameState& state = rules->state();
+    state.currentPlayer = redo.currentPlayer;
+    state.diceValue = redo.diceValue;
+    state.diceRolled = redo.diceRolled;
+
+    MoveUndo undo;
+    MoveResult result = rules->makeMove(redo.player, redo.tokenIndex, undo);
+    logMove(redo.player, redo.tokenIndex, result);
+    undoHistory.push_back(undo);
+    redoHistory.pop_back();
+    skipInactivePlayers();
 }
 
-void LudoGame::renderGame()
+void LudoGame::renderGame(const GameState& state)
 {
     window.clear(sf::Color::White);
     window.setPosition(sf::Vector2i(100, 100));
@@ -668,80 +575,52 @@ void LudoGame::renderGame()
 
     sf::ConvexShape star;
     star.setPointCount(10);
-    float radius = TILE_SIZE / 6.f;
-    float innerRadius = radius / 2.5f;
     for (int i = 0; i < 10; ++i) {
-        float angle = i * 36 * 3.14159f / 180;
-        float r = (i % 2 == 0) ? radius : innerRadius;
-        star.setPoint(i, sf::Vector2f(r * cos(angle), r * sin(angle)));
+        star.setPoint(i, starPoint(TILE_SIZE, i));
     }
     star.setFillColor(sf::Color::Black);
 
-    // Create a map to count tokens at each position
-    map<std::pair<int, int>, int> tokenPositionCount;
-    for (int player = 0; player < numPlayers; ++player) {
-        for (int i = 0; i < MAX_TOKENS_PER_PLAYER; ++i) {
-            const auto& tokenPos = playerTokens[player][i];
-            if (!finishedPlayerTokens[player][i]) {
-                tokenPositionCount[{tokenPos.x, tokenPos.y}]++;
-            }
-        }
-    }
-
+    TokenSprite sprites[MAX_PLAYERS][MAX_TOKENS_PER_PLAYER];
+    layoutTokens(state, TILE_SIZE, sprites);
     for (int player = 0; player < numPlayers; ++player) {
         for (int i = 0; i < MAX_TOKENS_PER_PLAYER; ++i) {
-            const auto& tokenPos = playerTokens[player][i];
-            if (finishedPlayerTokens[player][i]) continue;
-
-            int tokenCount = tokenPositionCount[{tokenPos.x, tokenPos.y}];
-
-            // Adjust the radius based on the number of tokens at the same position
-            float tokenRadius = (tokenCount > 1) ? TILE_SIZE / (3.f + tokenCount) : TILE_SIZE / 3.f;
-            token.setRadius(tokenRadius);
-            star.setScale(tokenCount > 1 ? 0.5f : 1.f, tokenCount > 1 ? 0.5f : 1.f);
+            const TokenSprite& sprite = sprites[player][i];
+            if (!sprite.visible) continue;
 
+            token.setRadius(sprite.radius);
             token.setFillColor(playerColors[player]);
-
-            // Calculate the offset to slightly separate tokens
-            float offset = (tokenCount > 1) ? TILE_SIZE / 8.f : 0.f;
-            float angleOffset = (tokenCount > 1) ? (i * 2 * 3.14159f / tokenCount) : 0.f;
-            float xOffset = offset * cos(angleOffset);
-            float yOffset = offset * sin(angleOffset);
-
-            // Adjust the position to avoid overlap
-            float adjustedXOffset = xOffset + (i % 2 == 0 ? -offset : offset);
-            float adjustedYOffset = yOffset + (i % 2 == 0 ? -offset : offset);
-
-            token.setPosition(tokenPos.y * TILE_SIZE + TILE_SIZE / 6.f + adjustedXOffset,
-                              tokenPos.x * TILE_SIZE + TILE_SIZE / 6.f + adjustedYOffset);
-            star.setPosition(token.getPosition() + sf::Vector2f(token.getRadius() - radius / 4.f, token.getRadius() - radius / 4.f));
+            token.setPosition(sprite.left, sprite.top);
+            star.setScale(sprite.starScale, sprite.starScale);
+            star.setPosition(sprite.starX, sprite.starY);
 
             window.draw(token);
             window.draw(star);
         }
     }
 
-    infoText.setString("Player " + to_string(currentPlayer + 1) +
-                       " | Dice: " + to_string(diceValue) +
-                       (diceRolled ? " | Click to move" : " | Click to roll"));
+    // Only rebuild the status string when it changes
+    int infoKey = (state.currentPlayer * 8 + state.diceValue) * 2 + state.diceRolled;
+    if (infoKey != lastInfoKey || clickLatency.count() != lastLatencyCount) {
+        string info = "Player " + to_string(state.currentPlayer + 1) +
+                      " | Dice: " + to_string(state.diceValue) +
+                      (state.diceRolled ? " | Click to move" : " | Click to roll");
+        double p50, p99;
+        if (clickLatency.percentiles(p50, p99)) {
+            char latency[64];
+            snprintf(latency, sizeof(latency), " | Click-to-pixel p50 %.1f ms, p99 %.1f ms", p50, p99);
+            info += latency;
+        }
+        infoText.setString(info);
+        lastInfoKey = infoKey;
+        lastLatencyCount = clickLatency.count();
+    }
     window.draw(infoText);
 
     window.display();
 }
 
 bool LudoGame::shouldSkipTurn(int player) {
-    if (find(finishingOrder.begin(), finishingOrder.end(), player) != finishingOrder.end()) {
-        return true;
-    }
-
-    for (int token = 0; token < MAX_TOKENS_PER_PLAYER; ++token) {
-        if (!finishedPlayerTokens[player][token]) {
-            return false;
-        }
-    }
-
-    finishingOrder.push_back(player);
-    return true;
+    return rules->shouldSkipTurn(player);
 }
 
 bool LudoGame::allPlayersFinished() {
@@ -759,7 +638,11 @@ void LudoGame::runGame()
     if (simulationMode) {
         simulateGameplay();
     } else {
+        sem_init(&inputReady, 0, 0);
+        renderState = rules->state();
         initializeThreads();
+        pthread_create(&logicThreadHandle, nullptr, LudoGame::logicThread, this);
+
         while (window.isOpen())
         {
             sf::Event event;
@@ -767,14 +650,45 @@ void LudoGame::runGame()
             {
                 if (event.type == sf::Event::Closed)
                     window.close();
-                if (event.type == sf::Event::MouseButtonPressed)
-                    handleMouseClick(event.mouseButton.x, event.mouseButton.y);
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::H && heatmap.games > 0)
+                    heatmapLayer = heatmapLayer + 1 < HEAT_LAYERS ? heatmapLayer + 1 : -1;
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Z)
+                    postInput(InputEvent{INPUT_UNDO, 0, 0, 0, 0});
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Y)
+                    postInput(InputEvent{INPUT_REDO, 0, 0, 0, 0});
+                if (event.type == sf::Event::MouseButtonPressed) {
+                    // Timestamp at capture; the latency sample is taken once a frame shows the result
+                    uint64_t sequence = ++inputSequence;
+                    inputCaptureTimes[sequence % INPUT_QUEUE_SIZE] = chrono::steady_clock::now();
+                    postInput(InputEvent{INPUT_CLICK, event.mouseButton.x, event.mouseButton.y, sequence, 0});
+                }
+            }
+
+            snapshotState();
+            updateTurnTimers();
+            if (publisher) {
+                publisher->publish(renderState, renderState.numPlayers - renderState.finishedPlayers - renderState.eliminatedPlayers <= 1);
             }
 
             window.clear(sf::Color::White);
             drawBoard();
-            renderGame();
+            renderGame(renderState);
             window.display();
+            measureInputLatency();
+        }
+
+        postInput(InputEvent{INPUT_QUIT, 0, 0, 0, 0});
+        pthread_join(logicThreadHandle, nullptr);
+
+        // Closing the window ends the feed even mid-game, so readers stop following it
+        if (publisher) {
+            publisher->publish(rules->state(), true);
+        }
+
+        double p50, p99;
+        if (clickLatency.percentiles(p50, p99)) {
+            cout << "Click-to-pixel latency over " << clickLatency.count() << " clicks: p50 "
+                 << p50 << " ms, p99 " << p99 << " ms" << endl;
         }
 
         // Join threads to ensure proper cleanup
@@ -788,23 +702,144 @@ void LudoGame::runGame()
     }
 }
 
+// Runs on the logic thread with gameMutex held
 void LudoGame::handleMouseClick(int x, int y)
 {
-    if (!diceRolled) {
-        diceValue = rollDice();
-        diceRolled = true;
+    const GameState& state = rules->state();
+    timedOutTurns[state.currentPlayer] = 0;
+
+    if (!state.diceRolled) {
+        rollDice();
     } else {
         int clickedRow = y / TILE_SIZE;
         int clickedCol = x / TILE_SIZE;
 
         for (int i = 0; i < MAX_TOKENS_PER_PLAYER; ++i) {
-            if (playerTokens[currentPlayer][i].x == clickedRow &&
-                playerTokens[currentPlayer][i].y == clickedCol) {
-                moveToken(currentPlayer, i);
+            if (tokenPosition(state, state.currentPlayer, i) == sf::Vector2i(clickedRow, clickedCol)) {
+                applyMove(state.currentPlayer, i);
+                skipInactivePlayers();
+                break;
+            }
+        }
+    }
+}
+
+void LudoGame::skipInactivePlayers()
+{
+    GameState& state = rules->state();
+    while (!gameIsOver() && shouldSkipTurn(state.currentPlayer)) {
+        state.currentPlayer = (state.currentPlayer + 1) % numPlayers;
+    }
+}
+
+void LudoGame::postInput(const InputEvent& event)
+{
+    // The logic thread drains far faster than input arrives; a full queue drops the event
+    if (inputQueue.push(event)) {
+        sem_post(&inputReady);
+    }
+}
+
+// Runs on the logic thread with gameMutex held
+void LudoGame::applyInput(const InputEvent& event)
+{
+    if (event.type == INPUT_CLICK) {
+        handleMouseClick(event.x, event.y);
+        appliedInputSequence = event.sequence;
+    } else if (event.type == INPUT_TURN_TIMEOUT) {
+        handleTurnTimeout(event.turnKey);
+    } else if (event.type == INPUT_UNDO) {
+        undoMove();
+    } else if (event.type == INPUT_REDO) {
+        redoMove();
+    }
+}
+
+void LudoGame::snapshotState()
+{
+    // Keep drawing the previous snapshot rather than wait for the logic thread
+    if (gameMutex.try_lock()) {
+        renderState = rules->state();
+        renderedInputSequence = appliedInputSequence;
+        gameMutex.unlock();
+    }
+}
+
+void LudoGame::measureInputLatency()
+{
+    // Every click up to renderedInputSequence is on screen as of this display()
+    auto now = chrono::steady_clock::now();
+    for (uint64_t sequence = measuredInputSequence + 1; sequence <= renderedInputSequence; ++sequence) {
+        chrono::duration<double, milli> latency = now - inputCaptureTimes[sequence % INPUT_QUEUE_SIZE];
+        clickLatency.add(latency.count());
+    }
+    measuredInputSequence = max(measuredInputSequence, renderedInputSequence);
+}
+
+int LudoGame::turnKey(const GameState& state)
+{
+    return (state.turn * MAX_PLAYERS + state.currentPlayer) * 2 + state.diceRolled;
+}
+
+void LudoGame::updateTurnTimers()
+{
+    // Every roll or move starts a fresh deadline for whoever has to act next
+    int key = turnKey(renderState);
+    bool over = renderState.numPlayers - renderState.finishedPlayers - renderState.eliminatedPlayers <= 1;
+    if (key != armedTurnKey && !over) {
+        turnTimers.schedule(&turnDeadline, TURN_TIMEOUT_MS / TIMER_TICK_MS);
+        armedTurnKey = key;
+    }
+
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - timerStart);
+    turnTimers.advance(elapsed.count() / TIMER_TICK_MS);
+}
+
+void LudoGame::onTurnTimeout(TimerNode*, void* context)
+{
+    // Fired on the event loop thread; the logic thread applies it like any other input
+    LudoGame* game = static_cast<LudoGame*>(context);
+    game->postInput(InputEvent{INPUT_TURN_TIMEOUT, 0, 0, 0, game->armedTurnKey});
+}
+
+// Runs on the logic thread with gameMutex held
+void LudoGame::handleTurnTimeout(int expectedTurnKey)
+{
+    GameState& state = rules->state();
+    int player = state.currentPlayer;
+
+    // The player acted after the deadline fired but before it was applied
+    if (turnKey(state) != expectedTurnKey) {
+        return;
+    }
+
+    if (!state.diceRolled) {
+        rollDice();
+        return;
+    }
+
+    // The player let the whole turn run out: move their first token that can still move,
+    // or pass on their first unfinished token when the dice move none
+    int legal = rules->legalMoves(player);
+    if (legal != 0) {
+        applyMove(player, __builtin_ctz(legal));
+    } else {
+        for (int i = 0; i < MAX_TOKENS_PER_PLAYER; ++i) {
+            if (!state.finished[player][i]) {
+                applyMove(player, i);
                 break;
             }
         }
     }
+
+    if (++timedOutTurns[player] >= IDLE_TURN_LIMIT) {
+        // Timeout eliminations are not part of the move record, so history stops here
+        rules->eliminatePlayer(player);
+        removePlayer(player);
+        undoHistory.clear();
+        redoHistory.clear();
+    }
+    skipInactivePlayers();
 }
 
 void LudoGame::drawBoard()
@@ -813,41 +848,47 @@ void LudoGame::drawBoard()
     cell.setOutlineThickness(1);
     cell.setOutlineColor(sf::Color::Black);
 
-    sf::Color red(sf::Color::Red);
-    sf::Color green(sf::Color::Green);
-    sf::Color blue(sf::Color::Blue);
-    sf::Color yellow(sf::Color::Yellow);
-    sf::Color white(sf::Color::White);
-    sf::Color black(sf::Color::Black);
-    sf::Color grey(sf::Color(128, 128, 128));
-
     for (int i = 0; i < GRID_SIZE; ++i) {
         for (int j = 0; j < GRID_SIZE; ++j) {
             cell.setPosition(j * TILE_SIZE, i * TILE_SIZE);
+            cell.setFillColor(cellColor(LudoBoard::cellKind(i, j)));
+            window.draw(cell);
+        }
+    }
+
+    if (heatmapLayer >= 0) {
+        drawHeatmap();
+    }
+}
+
+void LudoGame::setHeatmap(const CellHeatmap& cellHeatmap)
+{
+    heatmap = cellHeatmap;
+    heatmapLayer = heatmap.games > 0 ? HEAT_CAPTURES : -1;
+}
+
+void LudoGame::publishTo(const string& sharedName)
+{
+    publisher.reset(new StatePublisher(sharedName));
+}
 
-            if (i < 6 && j < 6)
-                cell.setFillColor(red);
-            else if (i > 8 && j < 6)
-                cell.setFillColor(yellow);
-            else if (i < 6 && j > 8)
-                cell.setFillColor(green);
-            else if (i > 8 && j > 8)
-                cell.setFillColor(blue);
-            else if (i == 7 && j >= 1 && j <= 6)
-                cell.setFillColor(red);
-            else if (j == 7 && i >= 1 && i <= 6)
-                cell.setFillColor(green);
-            else if (i == 7 && j >= 8 && j <= 13)
-                cell.setFillColor(blue);
-            else if (j == 7 && i >= 8 && i <= 13)
-                cell.setFillColor(yellow);
-            else if ((i == 7 && j == 7) || (i == 6 && j == 6) || (i == 6 && j == 8) || (i == 8 && j == 6) || (i == 8 && j == 8))
-                cell.setFillColor(black);
-            else if ((i == 2 && j == 6) || (i == 6 && j == 1) || (i == 13 && j == 6) || (i == 8 && j == 13) || (i == 6 && j == 12) || (i == 12 && j == 8) || (i == 8 && j == 2) || (i == 1 && j == 8))
-                cell.setFillColor(grey);
-            else
-                cell.setFillColor(white);
+void LudoGame::drawHeatmap()
+{
+    uint64_t peak = heatmap.maxCount(heatmapLayer);
+    if (peak == 0) {
+        return;
+    }
+
+    sf::RectangleShape cell(sf::Vector2f(TILE_SIZE, TILE_SIZE));
+    for (int i = 0; i < GRID_SIZE; ++i) {
+        for (int j = 0; j < GRID_SIZE; ++j) {
+            uint64_t count = heatmap.counts[heatmapLayer][LudoBoard::cell(i, j)];
+            if (count == 0) continue;
 
+            // Translucent orange-to-red, opaque enough to read the hottest cells over any board colour
+            double heat = static_cast<double>(count) / peak;
+            cell.setPosition(j * TILE_SIZE, i * TILE_SIZE);
+            cell.setFillColor(sf::Color(255, static_cast<sf::Uint8>(160 * (1 - heat)), 0, static_cast<sf::Uint8>(40 + 160 * heat)));
             window.draw(cell);
         }
     }
@@ -872,6 +913,8 @@ void LudoGame::displayFinishingOrder() {
     finishingOrderText.setCharacterSize(20);
     finishingOrderText.setFillColor(sf::Color::Black);
 
+    const int* finishingOrder = rules->state().finishingOrder;
+
     string orderText;
     if (teamMode) {
         // In team mode, show only the winning team
@@ -907,7 +950,7 @@ void LudoGame::displayFinishingOrder() {
         orderText = "Finishing Order:\n";
         const vector<string> placeSuffix = {"1st Place (Winner)", "2nd Place", "3rd Place"};
 
-        for (size_t i = 0; i < finishingOrder.size(); ++i) {
+        for (int i = 0; i < rules->state().finishedPlayers; ++i) {
             orderText += placeSuffix[i] + ": Player " + to_string(finishingOrder[i] + 1) + "\n";
         }
     }
@@ -936,39 +979,48 @@ void LudoGame::displayFinishingOrder() {
 void LudoGame::simulateGameplay()
 {
     window.setPosition(sf::Vector2i(100, 100));
+    mt19937 tokenPicker;
     while (window.isOpen()) {
         if (allPlayersFinished()) {
             displayFinishingOrder();
             break;
         }
 
-        if (shouldSkipTurn(currentPlayer)) {
-            cout << "Player " << currentPlayer + 1 << " has no tokens left to move." << endl;
-            currentPlayer = (currentPlayer + 1) % numPlayers;
+        GameState& state = rules->state();
+
+        if (shouldSkipTurn(state.currentPlayer)) {
+            logEvent(LOG_INFO, EVENT_NO_MOVES, state.currentPlayer);
+            state.currentPlayer = (state.currentPlayer + 1) % numPlayers;
             continue;
         }
 
-        if (!diceRolled) {
-            diceValue = rollDice();
-            diceRolled = true;
+        if (!state.diceRolled) {
+            rollDice();
         } else {
             int tokenIndex;
             do {
-                tokenIndex = uniform_int_distribution<>(0, MAX_TOKENS_PER_PLAYER - 1)(randomGenerator);
-            } while (finishedPlayerTokens[currentPlayer][tokenIndex]);
+                tokenIndex = uniform_int_distribution<>(0, MAX_TOKENS_PER_PLAYER - 1)(tokenPicker);
+            } while (state.finished[state.currentPlayer][tokenIndex]);
             
-            moveToken(currentPlayer, tokenIndex);
-            currentPlayer = (currentPlayer + 1) % numPlayers;
-            diceRolled = false;
+            moveToken(state.currentPlayer, tokenIndex);
+            state.currentPlayer = (state.currentPlayer + 1) % numPlayers;
+            state.diceRolled = false;
         }
 
-        renderGame();
+        if (publisher) {
+            publisher->publish(state, false);
+        }
+        renderGame(rules->state());
         this_thread::sleep_for(chrono::milliseconds(1));
     }
 
+    if (publisher) {
+        publisher->publish(rules->state(), true);
+    }
+
    
     sleep(2);
-    renderGame();
+    renderGame(rules->state());
     window.close();
 }
 
@@ -17,65 +17,117 @@
 #include <mutex>
 #include <condition_variable>
 #include <semaphore.h>
-#include <map>
+#include <memory>
+#include "ludo_engine.hpp"
+#include "timer_wheel.hpp"
+#include "input_queue.hpp"
+#include "cell_heatmap.hpp"
+#include "event_log.hpp"
+#include "state_publisher.hpp"
+#include "board_layout.hpp"
 
 using namespace std;
 
+class LudoGame;
+
+struct ThreadParams {
+    int player;
+    int row;
+    int column;
+    int hit_record;
+    LudoGame* game;
+};
+
 class LudoGame {
 public:
     LudoGame();
     void runGame();
     void simulateGameplay();
+    void setHeatmap(const CellHeatmap& cellHeatmap);
+    void publishTo(const string& sharedName);
 
 private:
     static const int GRID_SIZE = 15;
     static const int TILE_SIZE = 60;
     static const int MAX_TOKENS_PER_PLAYER = 4;
     static const int MAX_PLAYERS = 4;
+    static const int TURN_TIMEOUT_MS = 15000;
+    static const int TIMER_TICK_MS = 10;
+    static const int IDLE_TURN_LIMIT = 3;  // consecutive timed-out turns before elimination
+    static const int INPUT_QUEUE_SIZE = 256;
 
     sf::RenderWindow window;
     sf::Font defaultFont;
     sf::Text infoText;
 
     vector<sf::Color> playerColors;
-    vector<vector<sf::Vector2i>> playerTokens;
-    vector<vector<bool>> finishedPlayerTokens;
-    vector<sf::Vector2i> playerStartPositions;
-    vector<sf::Vector2i> ludoPath;
-    vector<sf::Vector2i> safeZones;
-    vector<vector<sf::Vector2i>> killersPath;
-    vector<bool> killers;
-    vector<int> finishingOrder;
+
+    // Rules and game state, specialised for the selected mode at startup
+    unique_ptr<RulesEngine> rules;
 
     bool teamMode;
     int numPlayers;
-    int currentPlayer;
-    int diceValue;
-    bool diceRolled;
     bool simulationMode;
+    int lastInfoKey;
+
+    // Turn deadlines: auto-roll, then auto-move, then eliminate idle players
+    TimerWheel turnTimers;
+    TimerNode turnDeadline;
+    int armedTurnKey;
+    int timedOutTurns[MAX_PLAYERS];
+    chrono::steady_clock::time_point timerStart;
+
+    // Input is queued by the event loop and applied by the logic thread, so a frame
+    // never waits on gameMutex. Frames draw from a snapshot taken with try_lock.
+    SpscQueue<InputEvent, INPUT_QUEUE_SIZE> inputQueue;
+    sem_t inputReady;
+    pthread_t logicThreadHandle;
+    uint64_t inputSequence;
+    chrono::steady_clock::time_point inputCaptureTimes[INPUT_QUEUE_SIZE];
+    uint64_t appliedInputSequence;      // guarded by gameMutex
+    GameState renderState;
+    uint64_t renderedInputSequence;     // last click visible in renderState
+    uint64_t measuredInputSequence;
+    LatencyTracker clickLatency;
+    long long lastLatencyCount;
+
+    // Simulation heatmap drawn over the board; H cycles through the layers and off
+    CellHeatmap heatmap;
+    int heatmapLayer;           // HeatmapLayer, or -1 when hidden
+
+    // Moves made this game, most recent last, and moves undone since the last new move.
+    // Guarded by gameMutex; Z undoes, Y redoes.
+    vector<MoveUndo> undoHistory;
+    vector<MoveUndo> redoHistory;
+
+    // Shared-memory feed for external viewers, written from the event loop thread
+    unique_ptr<StatePublisher> publisher;
 
     sem_t semaphore;
     condition_variable cv;
-    vector<int> consecutiveTurnsWithoutProgress;
 
-    mt19937 randomGenerator;
     mutex gameMutex;
 
     pthread_t playerThreads[MAX_PLAYERS];
     pthread_t rowColumnThreads[GRID_SIZE * 2];
     pthread_t masterThreadHandle;
+    ThreadParams playerThreadParams[MAX_PLAYERS];
+    ThreadParams rowColumnThreadParams[GRID_SIZE * 2];
 
     void initializeGame();
     int rollDice();
-    sf::Vector2i moveTokenOnBoard(sf::Vector2i token, int player, int tokenIndex);
     void moveToken(int player, int tokenIndex);
-    bool isTokenInYard(const sf::Vector2i& token, int player);
-    bool isSafeZone(const sf::Vector2i& position);
+    void applyMove(int player, int tokenIndex);
+    void undoMove();
+    void redoMove();
+    void logMove(int player, int tokenIndex, const MoveResult& result);
+    static sf::Vector2i tokenPosition(const GameState& state, int player, int tokenIndex);
     bool shouldSkipTurn(int player);
     bool allPlayersFinished();
-    void renderGame();
+    void renderGame(const GameState& state);
     void handleMouseClick(int x, int y);
     void drawBoard();
+    void drawHeatmap();
     void displayFinishingOrder();
     void askNumberOfPlayers(sf::RenderWindow& gameWindow);
     void initializeThreads();
@@ -84,9 +136,9 @@ private:
     static void* playerThread(void* arg);
     static void* rowColumnThread(void* arg);
     static void* masterThread(void* arg);
-    static void* gameThread(void* arg);
+    static void* logicThread(void* arg);
+    static void onTurnTimeout(TimerNode* node, void* context);
 
-    bool playerMadeProgress(int player);
     bool allTokensHome(int player);
     void finishPlayer(int player);
     void removePlayer(int player);
@@ -94,6 +146,14 @@ private:
     void checkForHits(int player, int token);
     bool areTeammates(int player1, int player2);
     void discardTurn(int player);
+    void skipInactivePlayers();
+    void updateTurnTimers();
+    static int turnKey(const GameState& state);
+    void handleTurnTimeout(int expectedTurnKey);
+    void postInput(const InputEvent& event);
+    void applyInput(const InputEvent& event);
+    void snapshotState();
+    void measureInputLatency();
 };
 
 #endif // LUDO_GAME_HPP
\ No newline at end of file
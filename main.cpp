@@ -1,13 +1,217 @@
+#include "alloc_counter.h"
+#include "ludo_engine.h"
+#include "timer_wheel.h"
+#include "input_queue.h"
+#include "cell_heatmap.h"
+#include "event_log.h"
+#include "state_publisher.h"
+#include "batch_simulator.h"
+#include "terminal_renderer.h"
+#include "strategy_tuner.h"
+#include "ludo_env.h"
+#include "dataset_export.h"
+#include "perft.h"
+#include "coroutine_turns.h"
+#include "board_layout.h"
+#include "mosaic_view.h"
+#include "replay_export.h"
 #include "ludo_game.hpp"
 #include "ludo_game.h"
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
+        string command = argc > 1 ? argv[1] : "";
+
+        if (command == "--batch") {
+            // Headless: ./ludo_game --batch --games 100000 --players 4
+            // Add --heatmap heatmap.csv to also export per-cell captures, blockades and landings,
+            // --shard K/N --out shardK.txt to play one slice for a later --merge
+            BatchConfig config = parseBatchOptions(argc, argv, 2);
+            CellHeatmap heatmap;
+            BatchResult result = runBatch(config, config.heatmapPath.empty() ? nullptr : &heatmap);
+            printBatchResult(config, result);
+            if (!config.resultPath.empty()) {
+                saveBatchResult(config.resultPath, config, result);
+            }
+            if (config.heatmapPath.empty()) {
+                return EXIT_SUCCESS;
+            }
+
+            printHeatmapSummary(heatmap);
+            saveHeatmap(config.heatmapPath, heatmap);
+            cout << "Saved heatmap to " << config.heatmapPath << endl;
+            return EXIT_SUCCESS;
+        }
+
+        if (command == "--merge") {
+            // ./ludo_game --merge shard0.txt shard1.txt ... [--out merged.txt]
+            vector<string> paths;
+            string outputPath;
+            for (int i = 2; i < argc; ++i) {
+                if (string(argv[i]) == "--out" && i + 1 < argc) {
+                    outputPath = argv[++i];
+                } else {
+                    paths.push_back(argv[i]);
+                }
+            }
+
+            BatchConfig config;
+            BatchResult result = mergeBatchResults(paths, config);
+            printBatchResult(config, result);
+            if (!outputPath.empty()) {
+                saveBatchResult(outputPath, config, result);
+            }
+            return EXIT_SUCCESS;
+        }
+
+        if (command == "--watch") {
+            // Headless observation over SSH: ./ludo_game --watch --delay 50
+            watchGame(parseBatchOptions(argc, argv, 2));
+            return EXIT_SUCCESS;
+        }
+
+        if (command == "--tune") {
+            // ./ludo_game --tune --generations 20 --population 24 --games 2000 --out best_weights.txt
+            TunerConfig config = parseTunerOptions(argc, argv, 2);
+            saveWeights(config.outputPath, tuneStrategy(config));
+            cout << "Saved best weights to " << config.outputPath << endl;
+            return EXIT_SUCCESS;
+        }
+
+        if (command == "--env-bench") {
+            // RL environment throughput: ./ludo_game --env-bench --games 1024 (games = environments)
+            BatchConfig config = parseBatchOptions(argc, argv, 2);
+            LudoEnvConfig envConfig = {config.rules.numPlayers, config.rules.teamMode, config.rules.killerRule,
+                                       config.rules.blockades, config.rules.inactivityElimination,
+                                       config.maxTurns, config.seed};
+            benchmarkEnvironment(envConfig, static_cast<int>(config.games));
+            return EXIT_SUCCESS;
+        }
+
+        if (command == "--check-env") {
+            // Regression for episodes that end before any decision: ./ludo_game --check-env --games 256
+            BatchConfig config = parseBatchOptions(argc, argv, 2);
+            int failures = 0;
+            for (int players = 2; players <= LudoBoard::MAX_PLAYERS; ++players) {
+                LudoEnvConfig envConfig = {players, false, config.rules.killerRule, config.rules.blockades,
+                                           config.rules.inactivityElimination, config.maxTurns, config.seed};
+                failures += checkEnvironment(envConfig, static_cast<int>(config.games), 2000);
+            }
+            cout << (failures == 0 ? "Every observation had a legal move." : to_string(failures) + " empty legal masks.") << endl;
+            return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        if (command == "--dataset") {
+            // Decision points for policy learning: ./ludo_game --dataset --games 100000 --out decisions.ludocol [--compress]
+            DatasetConfig config = parseDatasetOptions(argc, argv, 2);
+            uint64_t rows = exportDataset(config);
+            cout << "Wrote " << rows << " decisions to " << config.outputPath << endl;
+            return EXIT_SUCCESS;
+        }
+
+        if (command == "--dataset-info" && argc > 2) {
+            // ./ludo_game --dataset-info decisions.ludocol [--row N]
+            long long row = argc > 4 && string(argv[3]) == "--row" ? stoll(argv[4]) : -1;
+            printDatasetInfo(argv[2], row);
+            return EXIT_SUCCESS;
+        }
+
+        if (command == "--perft") {
+            // Move-tree counts from a seeded position: ./ludo_game --perft --depth 5 --plies 60 [--hash 256 --divide]
+            PerftConfig config = parsePerftOptions(argc, argv, 2);
+            printPerftResult(config, runPerft(config));
+            return EXIT_SUCCESS;
+        }
+
+        if (command == "--coro") {
+            // Many games waiting on slow agents, one thread: ./ludo_game --coro --games 10000 --agent-ms 5
+            CoroutineConfig config = parseCoroutineOptions(argc, argv, 2);
+            TurnExecutor executor;
+            BatchResult result = runCoroutineGames(config, executor);
+            printBatchResult(config.batch, result);
+            cout << "Resumes: " << executor.resumes() << " | peak games waiting on agents: "
+                 << executor.peakWaiting() << endl;
+            return EXIT_SUCCESS;
+        }
+
+        if (command == "--check-alloc") {
+            BatchConfig config = parseBatchOptions(argc, argv, 2);
+            return checkAllocations(config) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        if (command == "--mosaic") {
+            // Live random games side by side: ./ludo_game --mosaic --grid 8x8 --cell 96 [--moves-per-frame 2]
+            MosaicView mosaic(parseMosaicOptions(argc, argv, 2));
+            mosaic.run();
+            return EXIT_SUCCESS;
+        }
+
+        if (command == "--export-frames") {
+            // PNG sequence of one seeded game, no window needed: ./ludo_game --export-frames --game 42 --out frames
+            ReplayExportConfig config = parseReplayExportOptions(argc, argv, 2);
+            double seconds = 0;
+            size_t frames = exportReplay(config, seconds);
+            cout << "Wrote " << frames << " frames to " << config.outputDir << " in " << seconds << " s" << endl;
+            return EXIT_SUCCESS;
+        }
+
+        if (command == "--check-png") {
+            // Validate exported frames: ./ludo_game --check-png frames/*.png
+            int failures = 0;
+            for (int i = 2; i < argc; ++i) {
+                string problem = checkPng(argv[i]);
+                if (!problem.empty()) {
+                    cout << argv[i] << ": " << problem << endl;
+                    failures++;
+                }
+            }
+            cout << argc - 2 - failures << " of " << argc - 2 << " PNG files valid." << endl;
+            return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        if (command == "--attach" && argc > 2) {
+            // Follow a game published with --publish NAME from another process:
+            // ./ludo_game --attach NAME [--idle-timeout S]
+            int idleTimeout = argc > 4 && string(argv[3]) == "--idle-timeout" ? stoi(argv[4]) : 60;
+            attachViewer(argv[2], idleTimeout);
+            return EXIT_SUCCESS;
+        }
+
+        if (command == "--dump-log" && argc > 2) {
+            // Binary event log to JSON lines: ./ludo_game --dump-log events.bin
+            dumpEventLog(argv[2]);
+            return EXIT_SUCCESS;
+        }
+
+        // GUI options: --show-heatmap heatmap.csv overlays a heatmap, H cycles the layers;
+        // --log events.bin --log-format binary --log-level debug redirects the event log;
+        // --publish NAME shares the game state with --attach NAME readers
+        CellHeatmap heatmap;
+        bool showHeatmap = false;
+        string publishName;
+        for (int i = 1; i + 1 < argc; ++i) {
+            if (string(argv[i]) == "--show-heatmap") {
+                heatmap = loadHeatmap(argv[i + 1]);
+                showHeatmap = true;
+            } else if (string(argv[i]) == "--publish") {
+                publishName = argv[i + 1];
+            }
+        }
+        EventLog::get().start(parseLogOptions(argc, argv, 1));
+
         LudoGame game;
+        if (showHeatmap) {
+            game.setHeatmap(heatmap);
+        }
+        if (!publishName.empty()) {
+            game.publishTo(publishName);
+        }
         game.runGame();
+        EventLog::get().stop();
     } catch (const std::exception& e) {
+        EventLog::get().stop();
         std::cerr << "Error: " << e.what() << std::endl;
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
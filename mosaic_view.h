@@ -0,0 +1,190 @@
+#include "mosaic_view.hpp"
+
+MosaicView::MosaicView(const MosaicConfig& config)
+    : config(config),
+      window(sf::VideoMode(config.columns * config.cellPixels, config.rows * config.cellPixels), "Ludo mosaic"),
+      boards(sf::Triangles),
+      tokens(sf::Triangles),
+      nextSeed(0),
+      finishedGames(0)
+{
+    window.setFramerateLimit(60);
+
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+        float angle = i * 2 * 3.14159f / CIRCLE_SEGMENTS;
+        unitCircle[i] = sf::Vector2f(cos(angle), sin(angle));
+    }
+
+    for (int i = 0; i < config.columns * config.rows; ++i) {
+        games.push_back(makeRulesEngine(config.batch.rules, static_cast<uint32_t>(config.batch.seed + nextSeed++)));
+    }
+
+    buildBoardTexture();
+    buildBoards();
+}
+
+void MosaicView::buildBoardTexture()
+{
+    // drawBoard's cells and outlines, rasterised once
+    int size = LudoBoard::BOARD_SIZE * TEXTURE_TILE;
+    sf::Image image;
+    image.create(size, size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            image.setPixel(x, y, boardPixel(x, y, TEXTURE_TILE));
+        }
+    }
+
+    if (!boardTexture.loadFromImage(image)) {
+        throw runtime_error("Cannot create the board texture.");
+    }
+    boardTexture.setSmooth(true);
+}
+
+void MosaicView::buildBoards()
+{
+    float size = config.cellPixels;
+    float texture = LudoBoard::BOARD_SIZE * TEXTURE_TILE;
+    const sf::Vector2f corners[6] = {{0, 0}, {1, 0}, {1, 1}, {0, 0}, {1, 1}, {0, 1}};
+
+    for (int game = 0; game < static_cast<int>(games.size()); ++game) {
+        float left = (game % config.columns) * size;
+        float top = (game / config.columns) * size;
+        for (const sf::Vector2f& corner : corners) {
+            boards.append(sf::Vertex(sf::Vector2f(left + corner.x * size, top + corner.y * size), sf::Color::White,
+                                     sf::Vector2f(corner.x * texture, corner.y * texture)));
+        }
+    }
+}
+
+void MosaicView::stepGames()
+{
+    for (auto& game : games) {
+        for (int move = 0; move < config.movesPerFrame; ++move) {
+            if (game->gameIsOver() || game->state().turn >= config.batch.maxTurns) {
+                // Start the next seed in the finished game's place
+                game->reset(config.batch.rules.numPlayers, static_cast<uint32_t>(config.batch.seed + nextSeed++));
+                finishedGames++;
+            }
+            game->playRandomTurn();
+        }
+    }
+}
+
+void MosaicView::appendDisc(const sf::Vector2f& centre, float radius, const sf::Color& color)
+{
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+        const sf::Vector2f& a = unitCircle[i];
+        const sf::Vector2f& b = unitCircle[(i + 1) % CIRCLE_SEGMENTS];
+        tokens.append(sf::Vertex(centre, color));
+        tokens.append(sf::Vertex(sf::Vector2f(centre.x + a.x * radius, centre.y + a.y * radius), color));
+        tokens.append(sf::Vertex(sf::Vector2f(centre.x + b.x * radius, centre.y + b.y * radius), color));
+    }
+}
+
+void MosaicView::buildTokens()
+{
+    // Same layout as renderGame, scaled to the mosaic cell
+    float tile = static_cast<float>(config.cellPixels) / LudoBoard::BOARD_SIZE;
+    sf::Vector2f star[10];
+    for (int i = 0; i < 10; ++i) {
+        star[i] = starPoint(tile, i);
+    }
+
+    tokens.clear();
+    TokenSprite sprites[LudoBoard::MAX_PLAYERS][LudoBoard::MAX_TOKENS_PER_PLAYER];
+    for (int game = 0; game < static_cast<int>(games.size()); ++game) {
+        float left = (game % config.columns) * config.cellPixels;
+        float top = (game / config.columns) * config.cellPixels;
+        layoutTokens(games[game]->state(), tile, sprites);
+
+        for (int player = 0; player < LudoBoard::MAX_PLAYERS; ++player) {
+            for (int i = 0; i < LudoBoard::MAX_TOKENS_PER_PLAYER; ++i) {
+                const TokenSprite& sprite = sprites[player][i];
+                if (!sprite.visible) continue;
+
+                sf::Vector2f centre(left + sprite.left + sprite.radius, top + sprite.top + sprite.radius);
+                appendDisc(centre, sprite.radius + 0.5f, sf::Color::Black);
+                appendDisc(centre, sprite.radius, playerColor(player));
+
+                sf::Vector2f starCentre(left + sprite.starX, top + sprite.starY);
+                for (int point = 0; point < 10; ++point) {
+                    const sf::Vector2f& a = star[point];
+                    const sf::Vector2f& b = star[(point + 1) % 10];
+                    tokens.append(sf::Vertex(starCentre, sf::Color::Black));
+                    tokens.append(sf::Vertex(starCentre + sf::Vector2f(a.x * sprite.starScale, a.y * sprite.starScale), sf::Color::Black));
+                    tokens.append(sf::Vertex(starCentre + sf::Vector2f(b.x * sprite.starScale, b.y * sprite.starScale), sf::Color::Black));
+                }
+            }
+        }
+    }
+}
+
+void MosaicView::run()
+{
+    sf::RenderStates boardStates(&boardTexture);
+    auto second = chrono::steady_clock::now();
+    int frames = 0;
+
+    while (window.isOpen()) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed ||
+                (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)) {
+                window.close();
+            }
+        }
+
+        stepGames();
+        buildTokens();
+
+        window.clear(sf::Color::White);
+        window.draw(boards, boardStates);
+        window.draw(tokens);
+        window.display();
+
+        // Frame rate and progress in the title, refreshed once a second
+        frames++;
+        auto now = chrono::steady_clock::now();
+        if (now - second >= chrono::seconds(1)) {
+            window.setTitle("Ludo mosaic | " + to_string(games.size()) + " games | " + to_string(frames) +
+                            " fps | " + to_string(finishedGames) + " finished");
+            frames = 0;
+            second = now;
+        }
+    }
+}
+
+MosaicConfig parseMosaicOptions(int argc, char* argv[], int first)
+{
+    MosaicConfig config;
+    vector<char*> batchOptions;
+
+    for (int i = first; i < argc; ++i) {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (option == "--grid" && hasValue) {
+            // COLUMNSxROWS, e.g. 8x8
+            string grid = argv[++i];
+            size_t separator = grid.find('x');
+            if (separator == string::npos) {
+                throw runtime_error("Expected --grid COLUMNSxROWS, got " + grid);
+            }
+            config.columns = stoi(grid.substr(0, separator));
+            config.rows = stoi(grid.substr(separator + 1));
+        } else if (option == "--cell" && hasValue) {
+            config.cellPixels = stoi(argv[++i]);
+        } else if (option == "--moves-per-frame" && hasValue) {
+            config.movesPerFrame = stoi(argv[++i]);
+        } else {
+            batchOptions.push_back(argv[i]);
+        }
+    }
+
+    config.batch = parseBatchOptions(static_cast<int>(batchOptions.size()), batchOptions.data(), 0);
+    if (config.columns <= 0 || config.rows <= 0 || config.cellPixels <= 0) {
+        throw runtime_error("The mosaic grid and cell size must be positive.");
+    }
+    return config;
+}
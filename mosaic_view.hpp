@@ -0,0 +1,56 @@
+#ifndef MOSAIC_VIEW_HPP
+#define MOSAIC_VIEW_HPP
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ludo_engine.hpp"
+#include "batch_simulator.hpp"
+#include "board_layout.hpp"
+
+using namespace std;
+
+struct MosaicConfig {
+    BatchConfig batch;          // rules and seed; game g of the mosaic uses seed + g
+    int columns = 8;
+    int rows = 8;
+    int cellPixels = 96;        // on-screen size of one board
+    int movesPerFrame = 1;      // random moves each game plays per frame
+};
+
+// A columns x rows grid of live random games in one window. Every board is a quad
+// sampling one cached board texture, and all tokens of all games go into a single
+// vertex array, so a frame is two draw calls however many games are shown.
+class MosaicView {
+public:
+    explicit MosaicView(const MosaicConfig& config);
+    void run();
+
+private:
+    static const int TEXTURE_TILE = 16;     // board texture pixels per cell
+    static const int CIRCLE_SEGMENTS = 12;
+
+    MosaicConfig config;
+    sf::RenderWindow window;
+    sf::Texture boardTexture;
+    sf::VertexArray boards;     // textured, built once
+    sf::VertexArray tokens;     // rebuilt every frame
+    vector<unique_ptr<RulesEngine>> games;
+    long long nextSeed;
+    long long finishedGames;
+    sf::Vector2f unitCircle[CIRCLE_SEGMENTS];
+
+    void buildBoardTexture();
+    void buildBoards();
+    void stepGames();
+    void buildTokens();
+    void appendDisc(const sf::Vector2f& centre, float radius, const sf::Color& color);
+};
+
+MosaicConfig parseMosaicOptions(int argc, char* argv[], int first);
+
+#endif // MOSAIC_VIEW_HPP
@@ -0,0 +1,317 @@
+#include "perft.hpp"
+
+PerftCounts& PerftCounts::operator+=(const PerftCounts& other)
+{
+    nodes += other.nodes;
+    captures += other.captures;
+    finishes += other.finishes;
+    return *this;
+}
+
+PerftTable::PerftTable(size_t megabytes)
+{
+    size_t count = 1;
+    while (count * 2 * sizeof(Entry) <= megabytes << 20) {
+        count *= 2;
+    }
+    entries.reset(new Entry[count]);
+    for (size_t i = 0; i < count; ++i) {
+        entries[i].check = entries[i].nodes = entries[i].captures = entries[i].finishes = 0;
+    }
+    mask = count - 1;
+}
+
+static uint64_t perftKey(uint64_t key, int depth)
+{
+    return key ^ (static_cast<uint64_t>(depth) * 0x9e3779b97f4a7c15ull);
+}
+
+bool PerftTable::probe(uint64_t key, int depth, PerftCounts& counts) const
+{
+    uint64_t tagged = perftKey(key, depth);
+    const Entry& entry = entries[tagged & mask];
+    uint64_t check = entry.check.load(memory_order_relaxed);
+    PerftCounts stored;
+    stored.nodes = entry.nodes.load(memory_order_relaxed);
+    stored.captures = entry.captures.load(memory_order_relaxed);
+    stored.finishes = entry.finishes.load(memory_order_relaxed);
+
+    if ((check ^ stored.nodes ^ stored.captures ^ stored.finishes) != tagged) {
+        return false;
+    }
+    counts = stored;
+    return true;
+}
+
+void PerftTable::store(uint64_t key, int depth, const PerftCounts& counts)
+{
+    uint64_t tagged = perftKey(key, depth);
+    Entry& entry = entries[tagged & mask];
+    entry.check.store(tagged ^ counts.nodes ^ counts.captures ^ counts.finishes, memory_order_relaxed);
+    entry.nodes.store(counts.nodes, memory_order_relaxed);
+    entry.captures.store(counts.captures, memory_order_relaxed);
+    entry.finishes.store(counts.finishes, memory_order_relaxed);
+}
+
+uint64_t positionHash(const GameState& state)
+{
+    uint8_t key[48];
+    int length = 0;
+    for (int player = 0; player < LudoBoard::MAX_PLAYERS; ++player) {
+        for (int token = 0; token < LudoBoard::MAX_TOKENS_PER_PLAYER; ++token) {
+            key[length++] = state.tokens[player][token];
+            key[length++] = state.finished[player][token];
+        }
+        key[length++] = state.killers[player] | state.eliminated[player] << 1;
+        key[length++] = static_cast<uint8_t>(min(state.consecutiveTurnsWithoutProgress[player], 255));
+        key[length++] = static_cast<uint8_t>(state.finishingOrder[player]);
+    }
+    key[length++] = static_cast<uint8_t>(state.currentPlayer);
+
+    // FNV-1a, then a finaliser so the low bits used for the table index are well mixed
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (int i = 0; i < length; ++i) {
+        hash = (hash ^ key[i]) * 0x100000001b3ull;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Turn bookkeeping that skipping finished or eliminated players changes
+struct PerftTurn {
+    int currentPlayer;
+    int diceValue;
+    bool diceRolled;
+    int finishedPlayers;
+};
+
+// Moves on to the next player who has to act, as the turn loops do. Returns false
+// when the game is over. endTurn undoes it.
+template <class Rules>
+static bool beginTurn(LudoEngine<Rules>& engine, PerftTurn& saved)
+{
+    GameState& state = engine.state();
+    saved = PerftTurn{state.currentPlayer, state.diceValue, state.diceRolled, state.finishedPlayers};
+
+    while (!engine.gameIsOver() && engine.shouldSkipTurn(state.currentPlayer)) {
+        engine.advanceTurn();
+    }
+    return !engine.gameIsOver();
+}
+
+static void endTurn(GameState& state, const PerftTurn& saved)
+{
+    while (state.finishedPlayers > saved.finishedPlayers) {
+        state.finishingOrder[--state.finishedPlayers] = -1;
+    }
+    state.currentPlayer = saved.currentPlayer;
+    state.diceValue = saved.diceValue;
+    state.diceRolled = saved.diceRolled;
+}
+
+// Calls visit(dice, token, moved, result) with every ply made and unmade around it
+template <class Rules, class Visitor>
+static void forEachPly(LudoEngine<Rules>& engine, Visitor&& visit)
+{
+    GameState& state = engine.state();
+    int player = state.currentPlayer;
+
+    for (int dice = 1; dice <= 6; ++dice) {
+        state.diceValue = dice;
+        state.diceRolled = true;
+
+        int legal = engine.legalMoves(player);
+        bool moved = legal != 0;
+        if (!moved) {
+            // Any unfinished token plays the turn out; the first one stands for them all
+            int token = 0;
+            while (state.finished[player][token]) {
+                token++;
+            }
+            legal = 1 << token;
+        }
+
+        for (; legal; legal &= legal - 1) {
+            int token = __builtin_ctz(legal);
+            MoveUndo undo;
+            MoveResult result = engine.makeMove(player, token, undo);
+            visit(dice, token, moved, result);
+            engine.unmakeMove(undo);
+        }
+    }
+}
+
+static void countLeaf(PerftCounts& counts, const MoveResult& result)
+{
+    counts.nodes++;
+    counts.captures += result.capturedTokens != 0;
+    counts.finishes += result.tokenFinished;
+}
+
+template <class Rules>
+static void perftNode(LudoEngine<Rules>& engine, int depth, PerftTable* table, PerftCounts& counts)
+{
+    // Depth 1 is cheaper to enumerate than to look up
+    bool cached = table && depth >= 2;
+    uint64_t key = cached ? positionHash(engine.state()) : 0;
+    PerftCounts subtree;
+    if (cached && table->probe(key, depth, subtree)) {
+        counts += subtree;
+        return;
+    }
+
+    PerftTurn saved;
+    if (beginTurn(engine, saved)) {
+        forEachPly(engine, [&](int, int, bool, const MoveResult& result) {
+            if (depth == 1) {
+                countLeaf(subtree, result);
+            } else {
+                perftNode(engine, depth - 1, table, subtree);
+            }
+        });
+    }
+    endTurn(engine.state(), saved);
+
+    if (cached) {
+        table->store(key, depth, subtree);
+    }
+    counts += subtree;
+}
+
+struct PerftWorkerParams {
+    const PerftConfig* config;
+    const GameState* root;
+    vector<PerftDivide>* moves;
+    PerftTable* table;
+};
+
+template <class Rules>
+void* perftWorker(void* arg)
+{
+    WorkQueue* queue = static_cast<WorkQueue*>(arg);
+    PerftWorkerParams* params = static_cast<PerftWorkerParams*>(queue->context);
+    int depth = params->config->depth;
+
+    LudoEngine<Rules> engine;
+    engine.reset(params->root->numPlayers, 0);
+    GameState& state = engine.state();
+
+    size_t index;
+    while (queue->claim(index)) {
+        PerftDivide& move = (*params->moves)[index];
+        state = *params->root;
+        state.diceValue = move.dice;
+        state.diceRolled = true;
+
+        MoveUndo undo;
+        MoveResult result = engine.makeMove(state.currentPlayer, move.token, undo);
+        if (depth == 1) {
+            countLeaf(move.counts, result);
+        } else {
+            perftNode(engine, depth - 1, params->table, move.counts);
+        }
+    }
+
+    return nullptr;
+}
+
+template <class Rules>
+static PerftResult runPerftWith(const PerftConfig& config)
+{
+    const BatchConfig& batch = config.batch;
+    PerftResult result;
+
+    // Root: a fresh game with config.plies random plies played from the seed
+    LudoEngine<Rules> engine;
+    engine.reset(batch.rules.numPlayers, static_cast<uint32_t>(batch.seed));
+    for (int ply = 0; ply < config.plies && engine.playRandomTurn(); ++ply) {
+    }
+
+    if (config.depth == 0) {
+        result.total.nodes = 1;
+        return result;
+    }
+
+    PerftTurn saved;
+    if (!beginTurn(engine, saved)) {
+        return result;
+    }
+    forEachPly(engine, [&](int dice, int token, bool moved, const MoveResult&) {
+        result.divide.push_back(PerftDivide{dice, token, moved, PerftCounts()});
+    });
+    GameState root = engine.state();
+
+    unique_ptr<PerftTable> table;
+    if (config.hashMegabytes > 0) {
+        table.reset(new PerftTable(config.hashMegabytes));
+    }
+
+    auto start = chrono::steady_clock::now();
+    PerftWorkerParams params{&config, &root, &result.divide, table.get()};
+    WorkQueue queue{&params, result.divide.size()};
+    runWorkQueue(batch.threads, &perftWorker<Rules>, queue);
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    for (const PerftDivide& move : result.divide) {
+        result.total += move.counts;
+    }
+    return result;
+}
+
+PerftResult runPerft(const PerftConfig& config)
+{
+    PerftResult result;
+    dispatchRules(config.batch.rules, [&](auto rules) {
+        result = runPerftWith<decltype(rules)>(config);
+    });
+    return result;
+}
+
+void printPerftResult(const PerftConfig& config, const PerftResult& result)
+{
+    cout << "Perft depth " << config.depth << ", " << config.batch.rules.numPlayers << " players, root after "
+         << config.plies << " plies of seed " << config.batch.seed << endl;
+    if (config.divide) {
+        for (const PerftDivide& move : result.divide) {
+            cout << "  dice " << move.dice << (move.moved ? " token " + to_string(move.token) : string(" pass"))
+                 << ": " << move.counts.nodes << endl;
+        }
+    }
+    cout << "Nodes: " << result.total.nodes << " | captures: " << result.total.captures
+         << " | finishes: " << result.total.finishes << endl;
+    if (result.seconds > 0) {
+        cout << "Time: " << result.seconds << " s ("
+             << static_cast<long long>(result.total.nodes / result.seconds) << " nodes/s)" << endl;
+    }
+}
+
+PerftConfig parsePerftOptions(int argc, char* argv[], int first)
+{
+    PerftConfig config;
+    vector<char*> batchOptions;
+
+    for (int i = first; i < argc; ++i) {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (option == "--depth" && hasValue) {
+            config.depth = stoi(argv[++i]);
+        } else if (option == "--plies" && hasValue) {
+            config.plies = stoi(argv[++i]);
+        } else if (option == "--hash" && hasValue) {
+            config.hashMegabytes = stoul(argv[++i]);
+        } else if (option == "--divide") {
+            config.divide = true;
+        } else {
+            batchOptions.push_back(argv[i]);
+        }
+    }
+
+    config.batch = parseBatchOptions(static_cast<int>(batchOptions.size()), batchOptions.data(), 0);
+    if (config.depth < 0) {
+        throw runtime_error("Depth must not be negative.");
+    }
+    return config;
+}
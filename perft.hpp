@@ -0,0 +1,85 @@
+#ifndef PERFT_HPP
+#define PERFT_HPP
+
+#pragma once
+
+#include <pthread.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ludo_engine.hpp"
+#include "batch_simulator.hpp"
+
+using namespace std;
+
+// A ply is one dice value followed by one legal token move. A dice value that moves
+// nothing is a single ply that only passes the turn, as in the engine.
+struct PerftCounts {
+    uint64_t nodes = 0;         // positions exactly depth plies below the root
+    uint64_t captures = 0;      // last plies that sent at least one token to the yard
+    uint64_t finishes = 0;      // last plies that brought a token home
+
+    PerftCounts& operator+=(const PerftCounts& other);
+};
+
+struct PerftConfig {
+    BatchConfig batch;          // rules, threads; seed picks the root position
+    int depth = 4;
+    int plies = 0;              // random plies played from the seed to reach the root
+    size_t hashMegabytes = 0;   // 0 = no transposition cache
+    bool divide = false;        // print the counts below each root move
+};
+
+// Root move with the counts of its subtree
+struct PerftDivide {
+    int dice;
+    int token;
+    bool moved;                 // false when the dice moves nothing and token only passes the turn
+    PerftCounts counts;
+};
+
+struct PerftResult {
+    PerftCounts total;
+    vector<PerftDivide> divide;
+    double seconds = 0;
+};
+
+// Subtree counts keyed by position and remaining depth. Shared by all workers
+// without locks: every entry carries a check word XORed with its payload, so a torn
+// write reads as a miss. Keys are 64-bit hashes, so counts are exact barring collisions.
+class PerftTable {
+public:
+    explicit PerftTable(size_t megabytes);
+
+    bool probe(uint64_t key, int depth, PerftCounts& counts) const;
+    void store(uint64_t key, int depth, const PerftCounts& counts);
+
+private:
+    struct Entry {
+        atomic<uint64_t> check;
+        atomic<uint64_t> nodes;
+        atomic<uint64_t> captures;
+        atomic<uint64_t> finishes;
+    };
+
+    unique_ptr<Entry[]> entries;
+    size_t mask;
+};
+
+// Hash of everything the rules read: tokens, finished and killer flags, eliminations,
+// inactivity counters, finishing order and the player to move
+uint64_t positionHash(const GameState& state);
+
+// Enumerates every dice value and legal move to config.depth from the root position,
+// splitting the root moves across threads
+PerftResult runPerft(const PerftConfig& config);
+void printPerftResult(const PerftConfig& config, const PerftResult& result);
+
+// "--depth N --plies K --hash MB --divide" plus the batch options
+PerftConfig parsePerftOptions(int argc, char* argv[], int first);
+
+#endif // PERFT_HPP
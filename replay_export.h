@@ -0,0 +1,339 @@
+#include "replay_export.hpp"
+
+FrameCanvas::FrameCanvas(int width, int height)
+    : frameWidth(width),
+      frameHeight(height),
+      pixels(static_cast<size_t>(width) * height * 3, 255)
+{
+}
+
+void FrameCanvas::setPixel(int x, int y, const sf::Color& color)
+{
+    uint8_t* pixel = &pixels[(static_cast<size_t>(y) * frameWidth + x) * 3];
+    pixel[0] = color.r;
+    pixel[1] = color.g;
+    pixel[2] = color.b;
+}
+
+template <class Inside>
+void FrameCanvas::fillCoverage(float left, float top, float right, float bottom, const sf::Color& color, Inside&& inside)
+{
+    int x0 = max(0, static_cast<int>(floor(left)));
+    int y0 = max(0, static_cast<int>(floor(top)));
+    int x1 = min(frameWidth - 1, static_cast<int>(ceil(right)));
+    int y1 = min(frameHeight - 1, static_cast<int>(ceil(bottom)));
+
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            int covered = 0;
+            for (int sample = 0; sample < 16; ++sample) {
+                covered += inside(x + (sample % 4 + 0.5f) / 4, y + (sample / 4 + 0.5f) / 4);
+            }
+            if (covered == 0) continue;
+
+            uint8_t* pixel = &pixels[(static_cast<size_t>(y) * frameWidth + x) * 3];
+            const uint8_t source[3] = {color.r, color.g, color.b};
+            for (int channel = 0; channel < 3; ++channel) {
+                pixel[channel] = static_cast<uint8_t>((source[channel] * covered + pixel[channel] * (16 - covered) + 8) / 16);
+            }
+        }
+    }
+}
+
+void FrameCanvas::fillDisc(float centreX, float centreY, float radius, const sf::Color& color)
+{
+    float radiusSquared = radius * radius;
+    fillCoverage(centreX - radius, centreY - radius, centreX + radius, centreY + radius, color, [&](float x, float y) {
+        return (x - centreX) * (x - centreX) + (y - centreY) * (y - centreY) <= radiusSquared;
+    });
+}
+
+void FrameCanvas::fillPolygon(const sf::Vector2f* points, int count, const sf::Color& color)
+{
+    float left = points[0].x, top = points[0].y, right = points[0].x, bottom = points[0].y;
+    for (int i = 1; i < count; ++i) {
+        left = min(left, points[i].x);
+        top = min(top, points[i].y);
+        right = max(right, points[i].x);
+        bottom = max(bottom, points[i].y);
+    }
+
+    // Even-odd rule, so the concave star fills like SFML's fan from its centre
+    fillCoverage(left, top, right, bottom, color, [&](float x, float y) {
+        bool inside = false;
+        for (int i = 0, j = count - 1; i < count; j = i++) {
+            if ((points[i].y > y) != (points[j].y > y) &&
+                x < (points[j].x - points[i].x) * (y - points[i].y) / (points[j].y - points[i].y) + points[i].x) {
+                inside = !inside;
+            }
+        }
+        return inside;
+    });
+}
+
+void drawBoardFrame(FrameCanvas& canvas, int tile)
+{
+    for (int y = 0; y < canvas.height(); ++y) {
+        for (int x = 0; x < canvas.width(); ++x) {
+            canvas.setPixel(x, y, boardPixel(x, y, tile));
+        }
+    }
+}
+
+void drawTokensFrame(FrameCanvas& canvas, const GameState& state, int tile)
+{
+    TokenSprite sprites[LudoBoard::MAX_PLAYERS][LudoBoard::MAX_TOKENS_PER_PLAYER];
+    layoutTokens(state, tile, sprites);
+
+    for (int player = 0; player < state.numPlayers; ++player) {
+        for (int i = 0; i < LudoBoard::MAX_TOKENS_PER_PLAYER; ++i) {
+            const TokenSprite& sprite = sprites[player][i];
+            if (!sprite.visible) continue;
+
+            // renderGame's circle: one-pixel black outline outside the fill
+            float centreX = sprite.left + sprite.radius;
+            float centreY = sprite.top + sprite.radius;
+            canvas.fillDisc(centreX, centreY, sprite.radius + 1, sf::Color::Black);
+            canvas.fillDisc(centreX, centreY, sprite.radius, playerColor(player));
+
+            sf::Vector2f star[10];
+            for (int point = 0; point < 10; ++point) {
+                sf::Vector2f offset = starPoint(tile, point);
+                star[point] = sf::Vector2f(sprite.starX + offset.x * sprite.starScale, sprite.starY + offset.y * sprite.starScale);
+            }
+            canvas.fillPolygon(star, 10, sf::Color::Black);
+        }
+    }
+}
+
+static void writePngChunk(FILE* file, const char* type, const uint8_t* data, uint32_t length)
+{
+    uint8_t header[8] = {
+        static_cast<uint8_t>(length >> 24), static_cast<uint8_t>(length >> 16),
+        static_cast<uint8_t>(length >> 8), static_cast<uint8_t>(length),
+        static_cast<uint8_t>(type[0]), static_cast<uint8_t>(type[1]),
+        static_cast<uint8_t>(type[2]), static_cast<uint8_t>(type[3])
+    };
+    // crc32 with a null buffer returns the initial value, so empty chunks skip the data
+    uLong crc = crc32(0, header + 4, 4);
+    if (length > 0) {
+        crc = crc32(crc, data, length);
+    }
+    uint8_t trailer[4] = {
+        static_cast<uint8_t>(crc >> 24), static_cast<uint8_t>(crc >> 16),
+        static_cast<uint8_t>(crc >> 8), static_cast<uint8_t>(crc)
+    };
+
+    fwrite(header, 1, sizeof(header), file);
+    if (length > 0) {
+        fwrite(data, 1, length, file);
+    }
+    fwrite(trailer, 1, sizeof(trailer), file);
+}
+
+void writePng(const string& path, const FrameCanvas& canvas, vector<uint8_t>& scratch)
+{
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    int width = canvas.width();
+    int height = canvas.height();
+    size_t rowBytes = static_cast<size_t>(width) * 3;
+
+    // Every scanline uses the Up filter: the board is mostly vertical runs of one colour
+    size_t rawBytes = (rowBytes + 1) * height;
+    uLongf packedBytes = compressBound(rawBytes);
+    scratch.resize(rawBytes + packedBytes);
+    uint8_t* raw = scratch.data();
+    uint8_t* packed = raw + rawBytes;
+    const uint8_t* pixels = canvas.data();
+    for (int y = 0; y < height; ++y) {
+        uint8_t* line = raw + y * (rowBytes + 1);
+        const uint8_t* row = pixels + y * rowBytes;
+        line[0] = 2;
+        for (size_t i = 0; i < rowBytes; ++i) {
+            line[1 + i] = static_cast<uint8_t>(row[i] - (y > 0 ? row[i - rowBytes] : 0));
+        }
+    }
+    if (compress2(packed, &packedBytes, raw, rawBytes, 1) != Z_OK) {
+        throw runtime_error("zlib compression failed for " + path);
+    }
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        throw runtime_error("Cannot write " + path);
+    }
+    uint8_t header[13] = {
+        static_cast<uint8_t>(width >> 24), static_cast<uint8_t>(width >> 16),
+        static_cast<uint8_t>(width >> 8), static_cast<uint8_t>(width),
+        static_cast<uint8_t>(height >> 24), static_cast<uint8_t>(height >> 16),
+        static_cast<uint8_t>(height >> 8), static_cast<uint8_t>(height),
+        8, 2, 0, 0, 0           // 8-bit RGB, deflate, adaptive filtering, no interlace
+    };
+    fwrite(signature, 1, sizeof(signature), file);
+    writePngChunk(file, "IHDR", header, sizeof(header));
+    writePngChunk(file, "IDAT", packed, static_cast<uint32_t>(packedBytes));
+    writePngChunk(file, "IEND", nullptr, 0);
+    fclose(file);
+}
+
+static uint32_t readBigEndian(const uint8_t* bytes)
+{
+    return static_cast<uint32_t>(bytes[0]) << 24 | bytes[1] << 16 | bytes[2] << 8 | bytes[3];
+}
+
+string checkPng(const string& path)
+{
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    ifstream in(path, ios::binary);
+    vector<uint8_t> file((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    if (!in && !in.eof()) {
+        return "cannot read";
+    }
+    if (file.size() < 8 || !equal(signature, signature + 8, file.begin())) {
+        return "missing PNG signature";
+    }
+
+    uint32_t width = 0, height = 0;
+    vector<uint8_t> compressed;
+    bool ended = false;
+    for (size_t offset = 8; !ended; ) {
+        if (offset + 12 > file.size()) {
+            return "truncated chunk header";
+        }
+        uint32_t length = readBigEndian(&file[offset]);
+        if (offset + 12 + length > file.size()) {
+            return "truncated chunk";
+        }
+        const uint8_t* type = &file[offset + 4];
+        const uint8_t* data = type + 4;
+        string name(type, type + 4);
+
+        uLong crc = crc32(0, type, 4 + length);
+        if (crc != readBigEndian(data + length)) {
+            return "bad CRC in " + name;
+        }
+
+        if (name == "IHDR" && length >= 8) {
+            width = readBigEndian(data);
+            height = readBigEndian(data + 4);
+        } else if (name == "IDAT") {
+            compressed.insert(compressed.end(), data, data + length);
+        } else if (name == "IEND") {
+            ended = true;
+        }
+        offset += 12 + length;
+    }
+
+    // 8-bit RGB scanlines, each behind a filter byte
+    uLongf rawBytes = (static_cast<uLongf>(width) * 3 + 1) * height;
+    vector<uint8_t> raw(rawBytes);
+    if (width == 0 || height == 0 ||
+        uncompress(raw.data(), &rawBytes, compressed.data(), compressed.size()) != Z_OK ||
+        rawBytes != raw.size()) {
+        return "image data does not decode to the IHDR size";
+    }
+    return string();
+}
+
+vector<GameState> recordGame(const ReplayExportConfig& config)
+{
+    const BatchConfig& batch = config.batch;
+    vector<GameState> frames;
+
+    dispatchRules(batch.rules, [&](auto rules) {
+        LudoEngine<decltype(rules)> engine;
+        engine.reset(batch.rules.numPlayers, static_cast<uint32_t>(batch.seed + config.game));
+        frames.push_back(engine.state());
+        engine.playObservedGame(batch.maxTurns, [&](int, const MoveResult&) {
+            frames.push_back(engine.state());
+        });
+    });
+    return frames;
+}
+
+struct ReplayWorkerParams {
+    const ReplayExportConfig* config;
+    const vector<GameState>* frames;
+    const FrameCanvas* board;
+    mutex errorMutex;
+    string error;               // first failure of any worker
+};
+
+static void* replayWorker(void* arg)
+{
+    WorkQueue* queue = static_cast<WorkQueue*>(arg);
+    ReplayWorkerParams* params = static_cast<ReplayWorkerParams*>(queue->context);
+    FrameCanvas canvas(params->board->width(), params->board->height());
+    vector<uint8_t> scratch;
+    char name[32];
+
+    size_t frame;
+    while (queue->claim(frame)) {
+        canvas.copyFrom(*params->board);
+        drawTokensFrame(canvas, (*params->frames)[frame], params->config->tilePixels);
+
+        snprintf(name, sizeof(name), "/frame_%05zu.png", frame);
+        try {
+            writePng(params->config->outputDir + name, canvas, scratch);
+        } catch (const exception& e) {
+            lock_guard<mutex> lock(params->errorMutex);
+            if (params->error.empty()) {
+                params->error = e.what();
+            }
+            break;
+        }
+    }
+
+    return nullptr;
+}
+
+size_t exportReplay(const ReplayExportConfig& config, double& seconds)
+{
+    if (mkdir(config.outputDir.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw runtime_error("Cannot create " + config.outputDir);
+    }
+
+    auto start = chrono::steady_clock::now();
+    vector<GameState> frames = recordGame(config);
+
+    // The board never changes, so it is rasterised once and copied under each frame
+    int size = LudoBoard::BOARD_SIZE * config.tilePixels;
+    FrameCanvas board(size, size);
+    drawBoardFrame(board, config.tilePixels);
+
+    ReplayWorkerParams params{&config, &frames, &board, {}, string()};
+    WorkQueue queue{&params, frames.size()};
+    runWorkQueue(config.batch.threads, replayWorker, queue);
+    if (!params.error.empty()) {
+        throw runtime_error(params.error);
+    }
+
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return frames.size();
+}
+
+ReplayExportConfig parseReplayExportOptions(int argc, char* argv[], int first)
+{
+    ReplayExportConfig config;
+    vector<char*> batchOptions;
+
+    for (int i = first; i < argc; ++i) {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (option == "--game" && hasValue) {
+            config.game = stoll(argv[++i]);
+        } else if (option == "--out" && hasValue) {
+            config.outputDir = argv[++i];
+        } else if (option == "--tile" && hasValue) {
+            config.tilePixels = stoi(argv[++i]);
+        } else {
+            batchOptions.push_back(argv[i]);
+        }
+    }
+
+    config.batch = parseBatchOptions(static_cast<int>(batchOptions.size()), batchOptions.data(), 0);
+    if (config.tilePixels < 4) {
+        throw runtime_error("Tile size must be at least 4 pixels.");
+    }
+    return config;
+}
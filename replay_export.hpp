@@ -0,0 +1,75 @@
+#ifndef REPLAY_EXPORT_HPP
+#define REPLAY_EXPORT_HPP
+
+#pragma once
+
+#include <sys/stat.h>
+#include <pthread.h>
+#include <zlib.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ludo_engine.hpp"
+#include "batch_simulator.hpp"
+#include "board_layout.hpp"
+
+using namespace std;
+
+struct ReplayExportConfig {
+    BatchConfig batch;          // rules, seed, max turns, threads
+    long long game = 0;         // the game --batch plays with seed + game
+    string outputDir = "frames";
+    int tilePixels = 60;        // the GUI's TILE_SIZE
+};
+
+// RGB frame rendered on the CPU. Shapes are filled with 4x4 supersampled coverage,
+// the way an antialiased window would edge them.
+class FrameCanvas {
+public:
+    FrameCanvas(int width, int height);
+
+    void copyFrom(const FrameCanvas& other) { pixels = other.pixels; }
+    void setPixel(int x, int y, const sf::Color& color);
+    void fillDisc(float centreX, float centreY, float radius, const sf::Color& color);
+    void fillPolygon(const sf::Vector2f* points, int count, const sf::Color& color);
+
+    int width() const { return frameWidth; }
+    int height() const { return frameHeight; }
+    const uint8_t* data() const { return pixels.data(); }
+
+private:
+    int frameWidth;
+    int frameHeight;
+    vector<uint8_t> pixels;
+
+    template <class Inside>
+    void fillCoverage(float left, float top, float right, float bottom, const sf::Color& color, Inside&& inside);
+};
+
+// Board as drawBoard draws it, and the tokens and stars of state as renderGame draws them
+void drawBoardFrame(FrameCanvas& canvas, int tile);
+void drawTokensFrame(FrameCanvas& canvas, const GameState& state, int tile);
+
+// Writes an 8-bit RGB PNG; scratch is reused between calls to avoid reallocating
+void writePng(const string& path, const FrameCanvas& canvas, vector<uint8_t>& scratch);
+
+// Reads a PNG back, checking every chunk's CRC and that the image data inflates to the
+// size its header gives. Returns an empty string when the file is valid.
+string checkPng(const string& path);
+
+// Replays config.game and keeps the state before the first move and after every move
+vector<GameState> recordGame(const ReplayExportConfig& config);
+
+// Renders every recorded frame on all cores into outputDir/frame_NNNNN.png.
+// Returns the number of frames written.
+size_t exportReplay(const ReplayExportConfig& config, double& seconds);
+
+// "--game G --out DIR --tile PX" plus the batch options
+ReplayExportConfig parseReplayExportOptions(int argc, char* argv[], int first);
+
+#endif // REPLAY_EXPORT_HPP
@@ -1,2 +1,2 @@
-g++ -o ludo_game main.cpp -pthread -lsfml-graphics -lsfml-window -lsfml-system
+g++ -std=c++20 -o ludo_game main.cpp -pthread -lz -lsfml-graphics -lsfml-window -lsfml-system
 ./ludo_game
\ No newline at end of file
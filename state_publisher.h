@@ -0,0 +1,195 @@
+#include "state_publisher.hpp"
+
+static const char SHARED_STATE_MAGIC[8] = {'L', 'U', 'D', 'O', 'S', 'H', 'M', '1'};
+static const uint32_t SHARED_STATE_VERSION = 1;
+
+static string sharedMemoryName(const string& name)
+{
+    return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+
+static SharedStateRecord packState(const GameState& state, bool gameOver)
+{
+    SharedStateRecord record = {};
+    record.turn = static_cast<uint32_t>(state.turn);
+    for (int player = 0; player < LudoBoard::MAX_PLAYERS; ++player) {
+        for (int token = 0; token < LudoBoard::MAX_TOKENS_PER_PLAYER; ++token) {
+            record.tokens[player][token] = state.tokens[player][token];
+            record.finishedTokens |= state.finished[player][token] << (player * 4 + token);
+        }
+        record.finishingOrder[player] = static_cast<int8_t>(state.finishingOrder[player]);
+        record.killers |= state.killers[player] << player;
+        record.eliminated |= state.eliminated[player] << player;
+    }
+    record.numPlayers = static_cast<uint8_t>(state.numPlayers);
+    record.currentPlayer = static_cast<uint8_t>(state.currentPlayer);
+    record.diceValue = static_cast<uint8_t>(state.diceValue);
+    record.diceRolled = state.diceRolled;
+    record.gameOver = gameOver;
+    return record;
+}
+
+StatePublisher::StatePublisher(const string& sharedName, uint32_t capacity)
+    : name(sharedMemoryName(sharedName)),
+      mappedBytes(sizeof(SharedStateHeader) + capacity * sizeof(SharedStateSlot)),
+      sequence(0),
+      last{}
+{
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        throw runtime_error("Shared state capacity must be a power of two.");
+    }
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, mappedBytes) != 0) {
+        if (fd >= 0) close(fd);
+        throw runtime_error("Cannot create shared memory " + name);
+    }
+    void* memory = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw runtime_error("Cannot map shared memory " + name);
+    }
+
+    // ftruncate zero-fills, so every slot sequence and published start at 0
+    header = static_cast<SharedStateHeader*>(memory);
+    slots = reinterpret_cast<SharedStateSlot*>(header + 1);
+    header->version = SHARED_STATE_VERSION;
+    header->capacity = capacity;
+    header->slotSize = sizeof(SharedStateSlot);
+    atomic_thread_fence(memory_order_release);
+    memcpy(header->magic, SHARED_STATE_MAGIC, sizeof(SHARED_STATE_MAGIC));
+}
+
+StatePublisher::~StatePublisher()
+{
+    // Mapped readers keep their view; new ones can no longer attach
+    munmap(header, mappedBytes);
+    shm_unlink(name.c_str());
+}
+
+void StatePublisher::publish(const GameState& state, bool gameOver)
+{
+    SharedStateRecord record = packState(state, gameOver);
+    if (sequence > 0 && memcmp(&record, &last, sizeof(record)) == 0) {
+        return;
+    }
+
+    uint16_t moved = record.finishedTokens ^ last.finishedTokens;
+    for (int player = 0; player < LudoBoard::MAX_PLAYERS; ++player) {
+        for (int token = 0; token < LudoBoard::MAX_TOKENS_PER_PLAYER; ++token) {
+            if (record.tokens[player][token] != last.tokens[player][token]) {
+                moved |= 1 << (player * 4 + token);
+            }
+        }
+    }
+    last = record;
+    record.movedTokens = moved;
+
+    // Seqlock write: readers that see 0 or a newer sequence discard their copy
+    SharedStateSlot& slot = slots[++sequence & (header->capacity - 1)];
+    slot.sequence.store(0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(&slot.record, &record, sizeof(record));
+    slot.sequence.store(sequence, memory_order_release);
+    header->published.store(sequence, memory_order_release);
+}
+
+StateSubscriber::StateSubscriber(const string& sharedName)
+{
+    string name = sharedMemoryName(sharedName);
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SharedStateHeader)) {
+        if (fd >= 0) close(fd);
+        throw runtime_error("Cannot open shared memory " + name);
+    }
+
+    mappedBytes = info.st_size;
+    void* memory = mmap(nullptr, mappedBytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        throw runtime_error("Cannot map shared memory " + name);
+    }
+
+    header = static_cast<SharedStateHeader*>(memory);
+    slots = reinterpret_cast<SharedStateSlot*>(header + 1);
+    if (memcmp(header->magic, SHARED_STATE_MAGIC, sizeof(SHARED_STATE_MAGIC)) != 0 ||
+        header->version != SHARED_STATE_VERSION || header->slotSize != sizeof(SharedStateSlot) ||
+        mappedBytes < sizeof(SharedStateHeader) + header->capacity * sizeof(SharedStateSlot)) {
+        munmap(memory, mappedBytes);
+        throw runtime_error(name + " is not a Ludo state ring");
+    }
+
+    uint64_t published = header->published.load(memory_order_acquire);
+    cursor = published > 0 ? published - 1 : 0;
+}
+
+StateSubscriber::~StateSubscriber()
+{
+    munmap(header, mappedBytes);
+}
+
+bool StateSubscriber::next(SharedStateRecord& record, uint64_t& lost)
+{
+    while (true) {
+        uint64_t published = header->published.load(memory_order_acquire);
+        if (cursor >= published) {
+            return false;
+        }
+        if (published - cursor > header->capacity) {
+            lost += published - header->capacity - cursor;
+            cursor = published - header->capacity;
+        }
+
+        uint64_t wanted = cursor + 1;
+        const SharedStateSlot& slot = slots[wanted & (header->capacity - 1)];
+        if (slot.sequence.load(memory_order_acquire) == wanted) {
+            memcpy(&record, &slot.record, sizeof(record));
+            atomic_thread_fence(memory_order_acquire);
+            if (slot.sequence.load(memory_order_relaxed) == wanted) {
+                cursor = wanted;
+                return true;
+            }
+        }
+
+        // Overwritten while we looked: count it and move on
+        lost++;
+        cursor = wanted;
+    }
+}
+
+void attachViewer(const string& name, int idleTimeoutSeconds)
+{
+    StateSubscriber subscriber(name);
+    SharedStateRecord record;
+    uint64_t lost = 0;
+    auto lastRecord = chrono::steady_clock::now();
+
+    while (true) {
+        if (!subscriber.next(record, lost)) {
+            // A publisher that died never writes its game-over record
+            if (chrono::steady_clock::now() - lastRecord > chrono::seconds(idleTimeoutSeconds)) {
+                fprintf(stderr, "No new state on %s for %d s, detaching\n", name.c_str(), idleTimeoutSeconds);
+                break;
+            }
+            // Nothing new: back off; reading a record itself never enters the kernel
+            this_thread::sleep_for(chrono::milliseconds(1));
+            continue;
+        }
+        lastRecord = chrono::steady_clock::now();
+
+        printf("{\"turn\":%u,\"player\":%d,\"dice\":%d,\"moved\":%u,\"finished\":%u,\"tokens\":[",
+               record.turn, record.currentPlayer + 1, record.diceValue, record.movedTokens, record.finishedTokens);
+        for (int i = 0; i < LudoBoard::MAX_PLAYERS * LudoBoard::MAX_TOKENS_PER_PLAYER; ++i) {
+            printf(i ? ",%d" : "%d", record.tokens[i / 4][i % 4]);
+        }
+        printf("],\"lost\":%llu}\n", static_cast<unsigned long long>(lost));
+        // Readers are usually pipes, where stdout would otherwise be block-buffered
+        fflush(stdout);
+
+        if (record.gameOver) {
+            break;
+        }
+    }
+}
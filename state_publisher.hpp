@@ -0,0 +1,105 @@
+#ifndef STATE_PUBLISHER_HPP
+#define STATE_PUBLISHER_HPP
+
+#pragma once
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "ludo_engine.hpp"
+
+using namespace std;
+
+// Shared-memory layout, fixed so readers in other languages can map it directly:
+//   SharedStateHeader (128 bytes), then capacity slots of 64 bytes each.
+//   A slot is a uint64 sequence followed by a SharedStateRecord.
+// Sequence numbers start at 1. The writer zeroes a slot's sequence, fills the
+// record, then stores the sequence and header.published with release ordering.
+// A reader copies the record between two reads of the slot's sequence and keeps
+// the copy only if both equal the sequence it wanted.
+struct SharedStateRecord {
+    uint32_t turn;
+    uint16_t movedTokens;       // bit player*4+token: changed since the previous record
+    uint16_t finishedTokens;    // bit player*4+token
+    uint8_t tokens[LudoBoard::MAX_PLAYERS][LudoBoard::MAX_TOKENS_PER_PLAYER];  // row*15+column
+    int8_t finishingOrder[LudoBoard::MAX_PLAYERS];
+    uint8_t numPlayers;
+    uint8_t currentPlayer;
+    uint8_t diceValue;
+    uint8_t diceRolled;
+    uint8_t killers;            // bit per player
+    uint8_t eliminated;         // bit per player
+    uint8_t gameOver;
+    uint8_t reserved[21];
+};
+static_assert(sizeof(SharedStateRecord) == 56, "SharedStateRecord layout is shared with other processes");
+
+struct SharedStateSlot {
+    atomic<uint64_t> sequence;
+    SharedStateRecord record;
+};
+static_assert(sizeof(SharedStateSlot) == 64, "SharedStateSlot layout is shared with other processes");
+
+struct SharedStateHeader {
+    char magic[8];              // "LUDOSHM1"
+    uint32_t version;
+    uint32_t capacity;          // slots, a power of two
+    uint32_t slotSize;
+    uint32_t reserved;
+    alignas(64) atomic<uint64_t> published;     // last sequence written, 0 = none yet
+    char padding[56];
+};
+static_assert(sizeof(SharedStateHeader) == 128, "SharedStateHeader layout is shared with other processes");
+static_assert(atomic<uint64_t>::is_always_lock_free, "Sequences must be lock-free to be shared between processes");
+
+// Single producer. publish() never waits for readers: a reader that falls more than
+// capacity records behind loses the oldest ones, and since every record carries the
+// full packed state it resynchronises from the next record it reads.
+class StatePublisher {
+public:
+    StatePublisher(const string& name, uint32_t capacity = 4096);
+    ~StatePublisher();
+
+    // Writes a record when anything changed since the last call
+    void publish(const GameState& state, bool gameOver);
+    uint64_t published() const { return sequence; }
+
+private:
+    string name;
+    size_t mappedBytes;
+    SharedStateHeader* header;
+    SharedStateSlot* slots;
+    uint64_t sequence;
+    SharedStateRecord last;
+};
+
+class StateSubscriber {
+public:
+    explicit StateSubscriber(const string& name);
+    ~StateSubscriber();
+
+    // Copies the next record, starting from the newest one at attach time. Returns
+    // false when there is nothing new; records overwritten before they were read are
+    // added to lost.
+    bool next(SharedStateRecord& record, uint64_t& lost);
+
+private:
+    size_t mappedBytes;
+    SharedStateHeader* header;
+    SharedStateSlot* slots;
+    uint64_t cursor;
+};
+
+// Prints a published game as JSON lines until it ends: ./ludo_game --attach /ludo
+void attachViewer(const string& name, int idleTimeoutSeconds = 60);
+
+#endif // STATE_PUBLISHER_HPP
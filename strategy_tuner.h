@@ -0,0 +1,316 @@
+#include "strategy_tuner.hpp"
+
+const char* StrategyWeights::name(int index)
+{
+    static const char* const names[COUNT] = {"capture", "safety", "enterOnSix", "blockade", "homeProgress"};
+    return names[index];
+}
+
+// Position along the player's home path: -1 in the yard, KILLER_PATH_LENGTH once finished
+static int homePathIndex(const GameState& state, int player, int tokenIndex)
+{
+    const LudoBoard& board = LudoBoard::get();
+    uint8_t token = state.tokens[player][tokenIndex];
+
+    if (state.finished[player][tokenIndex]) {
+        return LudoBoard::KILLER_PATH_LENGTH;
+    }
+    if (board.yardOwner[token] == player) {
+        return -1;
+    }
+    return board.killersPathIndex[player][token];
+}
+
+template <class Rules>
+int chooseHeuristicToken(LudoEngine<Rules>& engine, int player, const StrategyWeights& weights)
+{
+    const GameState saved = engine.state();
+
+    int legal = engine.legalMoves(player);
+    if (legal == 0) {
+        // Nothing moves: play the turn out on the first unfinished token
+        int token = 0;
+        while (saved.finished[player][token]) {
+            token++;
+        }
+        return token;
+    }
+
+    // Try each token the dice moves on the live engine and roll the state back afterwards
+    int bestToken = -1;
+    double bestScore = 0;
+    for (int moves = legal; moves != 0; moves &= moves - 1) {
+        int token = __builtin_ctz(moves);
+        uint8_t from = saved.tokens[player][token];
+        MoveResult result = engine.moveToken(player, token);
+
+        double features[StrategyWeights::COUNT] = {
+            static_cast<double>(__builtin_popcount(result.capturedTokens)),
+            engine.isSafeZone(result.to) ? 1.0 : 0.0,
+            engine.isTokenInYard(from, player) ? 1.0 : 0.0,
+            !engine.isSafeZone(result.to) && engine.tokenCountAt(player, result.to) >= 2 ? 1.0 : 0.0,
+            static_cast<double>(homePathIndex(engine.state(), player, token) - homePathIndex(saved, player, token)) / LudoBoard::KILLER_PATH_LENGTH
+        };
+        engine.state() = saved;
+
+        double score = 0;
+        for (int i = 0; i < StrategyWeights::COUNT; ++i) {
+            score += weights.values[i] * features[i];
+        }
+        if (bestToken < 0 || score > bestScore) {
+            bestToken = token;
+            bestScore = score;
+        }
+    }
+
+    return bestToken;
+}
+
+// Plays one game with the bot in botSeat. weights == nullptr makes the bot random too.
+template <class Rules>
+bool playTunedGame(LudoEngine<Rules>& engine, const StrategyWeights* weights, int botSeat, mt19937& opponentRandom, int maxTurns)
+{
+    GameState& state = engine.state();
+
+    while (!engine.gameIsOver() && state.turn < maxTurns) {
+        int player = state.currentPlayer;
+        if (engine.shouldSkipTurn(player)) {
+            engine.advanceTurn();
+            continue;
+        }
+
+        engine.rollDice();
+        int token = (player == botSeat && weights) ? chooseHeuristicToken(engine, player, *weights)
+                                                   : engine.pickRandomToken(player, opponentRandom);
+        engine.moveToken(player, token);
+    }
+
+    return state.finishedPlayers > 0 && state.finishingOrder[0] == botSeat;
+}
+
+struct TunerWorkItem {
+    int candidate;              // -1 evaluates the random baseline
+    long long firstGame;
+    long long lastGame;
+    long long wins;
+};
+
+struct TunerWorkerParams {
+    const TunerConfig* config;
+    const vector<TunedCandidate>* candidates;
+    vector<TunerWorkItem>* items;
+    uint64_t seedBase;
+};
+
+template <class Rules>
+void* tunerWorker(void* arg)
+{
+    WorkQueue* queue = static_cast<WorkQueue*>(arg);
+    TunerWorkerParams* params = static_cast<TunerWorkerParams*>(queue->context);
+    const BatchConfig& batch = params->config->batch;
+    int numPlayers = batch.rules.numPlayers;
+
+    LudoEngine<Rules> engine;
+    mt19937 opponentRandom;
+
+    size_t index;
+    while (queue->claim(index)) {
+        TunerWorkItem& item = (*params->items)[index];
+        const StrategyWeights* weights = item.candidate < 0 ? nullptr : &(*params->candidates)[item.candidate].weights;
+
+        for (long long game = item.firstGame; game < item.lastGame; ++game) {
+            // Same dice and opponent choices for every candidate: common random numbers
+            uint32_t seed = static_cast<uint32_t>(params->seedBase + game);
+            engine.reset(numPlayers, seed);
+            opponentRandom.seed(seed ^ 0x9e3779b9u);
+            item.wins += playTunedGame(engine, weights, static_cast<int>(game % numPlayers), opponentRandom, batch.maxTurns);
+        }
+    }
+
+    return nullptr;
+}
+
+// Fills candidate fitness (and returns the random baseline's win rate) over one seed set
+static double evaluateCandidates(const TunerConfig& config, vector<TunedCandidate>& candidates, uint64_t seedBase)
+{
+    const BatchConfig& batch = config.batch;
+    const long long chunk = 256;
+
+    vector<TunerWorkItem> items;
+    for (int candidate = -1; candidate < static_cast<int>(candidates.size()); ++candidate) {
+        for (long long first = 0; first < batch.games; first += chunk) {
+            items.push_back(TunerWorkItem{candidate, first, min(batch.games, first + chunk), 0});
+        }
+    }
+
+    void* (*worker)(void*) = nullptr;
+    dispatchRules(batch.rules, [&](auto rules) {
+        worker = &tunerWorker<decltype(rules)>;
+    });
+
+    TunerWorkerParams params{&config, &candidates, &items, seedBase};
+    WorkQueue queue{&params, items.size()};
+    runWorkQueue(batch.threads, worker, queue);
+
+    long long baselineWins = 0;
+    for (auto& candidate : candidates) {
+        candidate.fitness = 0;
+    }
+    for (const auto& item : items) {
+        if (item.candidate < 0) {
+            baselineWins += item.wins;
+        } else {
+            candidates[item.candidate].fitness += item.wins;
+        }
+    }
+    for (auto& candidate : candidates) {
+        candidate.fitness /= batch.games;
+    }
+
+    return static_cast<double>(baselineWins) / batch.games;
+}
+
+static void printCandidate(const TunedCandidate& candidate)
+{
+    cout << "win rate " << candidate.fitness << " (";
+    for (int i = 0; i < StrategyWeights::COUNT; ++i) {
+        cout << (i ? ", " : "") << StrategyWeights::name(i) << " " << candidate.weights.values[i];
+    }
+    cout << ")" << endl;
+}
+
+vector<TunedCandidate> tuneStrategy(const TunerConfig& config)
+{
+    mt19937 random(static_cast<uint32_t>(config.batch.seed));
+    uniform_real_distribution<> initial(-1.0, 1.0);
+    uniform_real_distribution<> blend(-0.25, 1.25);
+    uniform_real_distribution<> chance(0.0, 1.0);
+    normal_distribution<> mutation(0.0, 0.2);
+
+    vector<TunedCandidate> population(config.population);
+    for (auto& candidate : population) {
+        for (double& value : candidate.weights.values) {
+            value = initial(random);
+        }
+    }
+
+    auto tournament = [&]() -> const TunedCandidate& {
+        uniform_int_distribution<> pick(0, config.population - 1);
+        const TunedCandidate* best = &population[pick(random)];
+        for (int i = 0; i < 2; ++i) {
+            const TunedCandidate& other = population[pick(random)];
+            if (other.fitness > best->fitness) {
+                best = &other;
+            }
+        }
+        return *best;
+    };
+
+    for (int generation = 0; generation < config.generations; ++generation) {
+        // A fresh seed set per generation so the weights do not overfit one set of games
+        uint64_t seedBase = config.batch.seed + static_cast<uint64_t>(generation) * config.batch.games;
+        double baseline = evaluateCandidates(config, population, seedBase);
+
+        sort(population.begin(), population.end(), [](const TunedCandidate& a, const TunedCandidate& b) {
+            return a.fitness > b.fitness;
+        });
+        cout << "Generation " << generation + 1 << ": random baseline " << baseline << ", best ";
+        printCandidate(population[0]);
+
+        if (generation + 1 == config.generations) {
+            break;
+        }
+
+        vector<TunedCandidate> next(population.begin(), population.begin() + min(config.elites, config.population));
+        while (static_cast<int>(next.size()) < config.population) {
+            const TunedCandidate& a = tournament();
+            const TunedCandidate& b = tournament();
+            TunedCandidate child;
+            for (int i = 0; i < StrategyWeights::COUNT; ++i) {
+                child.weights.values[i] = a.weights.values[i] + blend(random) * (b.weights.values[i] - a.weights.values[i]);
+                if (chance(random) < 0.3) {
+                    child.weights.values[i] += mutation(random);
+                }
+            }
+            next.push_back(child);
+        }
+        population.swap(next);
+    }
+
+    population.resize(min(config.saveCount, config.population));
+    return population;
+}
+
+void saveWeights(const string& path, const vector<TunedCandidate>& candidates)
+{
+    ofstream out(path);
+    if (!out) {
+        throw runtime_error("Cannot write " + path);
+    }
+
+    out << "# winRate";
+    for (int i = 0; i < StrategyWeights::COUNT; ++i) {
+        out << " " << StrategyWeights::name(i);
+    }
+    out << "\n";
+    for (const auto& candidate : candidates) {
+        out << candidate.fitness;
+        for (double value : candidate.weights.values) {
+            out << " " << value;
+        }
+        out << "\n";
+    }
+}
+
+vector<StrategyWeights> loadWeights(const string& path)
+{
+    ifstream in(path);
+    if (!in) {
+        throw runtime_error("Cannot read " + path);
+    }
+
+    vector<StrategyWeights> weights;
+    string line;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        istringstream fields(line);
+        double fitness;
+        StrategyWeights entry;
+        fields >> fitness;
+        for (double& value : entry.values) {
+            fields >> value;
+        }
+        weights.push_back(entry);
+    }
+    return weights;
+}
+
+TunerConfig parseTunerOptions(int argc, char* argv[], int first)
+{
+    TunerConfig config;
+    vector<char*> batchOptions;
+
+    for (int i = first; i < argc; ++i) {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (option == "--generations" && hasValue) {
+            config.generations = stoi(argv[++i]);
+        } else if (option == "--population" && hasValue) {
+            config.population = stoi(argv[++i]);
+        } else if (option == "--save" && hasValue) {
+            config.saveCount = stoi(argv[++i]);
+        } else if (option == "--out" && hasValue) {
+            config.outputPath = argv[++i];
+        } else {
+            batchOptions.push_back(argv[i]);
+        }
+    }
+
+    config.batch = parseBatchOptions(static_cast<int>(batchOptions.size()), batchOptions.data(), 0);
+    if (config.population < 2) {
+        throw runtime_error("Population must be at least 2.");
+    }
+    return config;
+}
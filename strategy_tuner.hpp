@@ -0,0 +1,60 @@
+#ifndef STRATEGY_TUNER_HPP
+#define STRATEGY_TUNER_HPP
+
+#pragma once
+
+#include <pthread.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ludo_engine.hpp"
+#include "batch_simulator.hpp"
+
+using namespace std;
+
+// Weights of the heuristic bot. Each candidate move is scored as the weighted sum
+// of its features and the best-scoring token is moved.
+struct StrategyWeights {
+    static const int COUNT = 5;
+    double values[COUNT] = {};
+
+    double& capture() { return values[0]; }         // opponent tokens sent to the yard
+    double& safety() { return values[1]; }          // landing on a safe zone
+    double& enterOnSix() { return values[2]; }      // bringing a token out of the yard
+    double& blockade() { return values[3]; }        // forming a stack of two or more
+    double& homeProgress() { return values[4]; }    // fraction of the home path advanced
+
+    static const char* name(int index);
+};
+
+struct TunerConfig {
+    BatchConfig batch;          // rules, games per candidate, seed, threads, max turns
+    int generations = 20;
+    int population = 24;
+    int elites = 2;
+    int saveCount = 3;
+    string outputPath = "best_weights.txt";
+};
+
+struct TunedCandidate {
+    StrategyWeights weights;
+    double fitness = 0;         // bot win rate against random opponents
+};
+
+// Picks the token the weighted heuristic prefers among those the engine's current dice
+// value moves; the first unfinished token when none moves
+template <class Rules>
+int chooseHeuristicToken(LudoEngine<Rules>& engine, int player, const StrategyWeights& weights);
+
+// Genetic algorithm over StrategyWeights. Every candidate in a generation plays the
+// same seeded games (common random numbers) against simulateGameplay-style random
+// opponents, and the work is spread over all cores.
+vector<TunedCandidate> tuneStrategy(const TunerConfig& config);
+
+void saveWeights(const string& path, const vector<TunedCandidate>& candidates);
+vector<StrategyWeights> loadWeights(const string& path);
+
+TunerConfig parseTunerOptions(int argc, char* argv[], int first);
+
+#endif // STRATEGY_TUNER_HPP
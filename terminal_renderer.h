@@ -0,0 +1,180 @@
+#include "terminal_renderer.hpp"
+
+static const char* const PLAYER_LETTERS = "RGBY";
+
+// Background SGR codes indexed by CellKind
+static const int CELL_BACKGROUNDS[] = {47, 41, 42, 44, 43, 40, 100};
+
+TerminalRenderer::TerminalRenderer(int fd)
+    : fd(fd),
+      frameValid(false),
+      lastBackground(-1),
+      totalBytes(0)
+{
+    status[0] = '\0';
+    output.reserve(16 * 1024);
+}
+
+TerminalRenderer::~TerminalRenderer()
+{
+    output.clear();
+    moveCursor(LudoBoard::BOARD_SIZE + 1, 0);
+    output += "\x1b[0m\x1b[?25h\n";
+    flush();
+}
+
+void TerminalRenderer::buildFrame(const GameState& state, TerminalCell next[LudoBoard::BOARD_SIZE][LudoBoard::BOARD_SIZE])
+{
+    int tokenCount[LudoBoard::CELL_COUNT] = {};
+    int8_t tokenOwner[LudoBoard::CELL_COUNT];
+    memset(tokenOwner, -1, sizeof(tokenOwner));
+
+    for (int player = 0; player < state.numPlayers; ++player) {
+        for (int token = 0; token < LudoBoard::MAX_TOKENS_PER_PLAYER; ++token) {
+            if (state.finished[player][token]) continue;
+
+            uint8_t cell = state.tokens[player][token];
+            tokenCount[cell]++;
+            // Mixed stacks are marked with -2
+            tokenOwner[cell] = (tokenOwner[cell] == -1 || tokenOwner[cell] == player) ? player : -2;
+        }
+    }
+
+    for (int row = 0; row < LudoBoard::BOARD_SIZE; ++row) {
+        for (int column = 0; column < LudoBoard::BOARD_SIZE; ++column) {
+            uint8_t cell = LudoBoard::cell(row, column);
+            TerminalCell& out = next[row][column];
+            out.background = LudoBoard::cellKind(row, column);
+            out.glyph[0] = ' ';
+            out.glyph[1] = ' ';
+
+            if (tokenCount[cell] == 0) continue;
+
+            if (tokenOwner[cell] >= 0) {
+                out.background = LudoBoard::playerCellKind(tokenOwner[cell]);
+                out.glyph[0] = PLAYER_LETTERS[tokenOwner[cell]];
+            } else {
+                out.glyph[0] = '*';
+            }
+            out.glyph[1] = tokenCount[cell] > 1 ? static_cast<char>('0' + tokenCount[cell]) : ' ';
+        }
+    }
+}
+
+void TerminalRenderer::moveCursor(int row, int column)
+{
+    char sequence[16];
+    int length = snprintf(sequence, sizeof(sequence), "\x1b[%d;%dH", row + 1, column * 2 + 1);
+    output.append(sequence, length);
+}
+
+void TerminalRenderer::emitCell(const TerminalCell& cell)
+{
+    int background = CELL_BACKGROUNDS[cell.background];
+    if (background != lastBackground) {
+        char sequence[16];
+        int length = snprintf(sequence, sizeof(sequence), "\x1b[30;1;%dm", background);
+        output.append(sequence, length);
+        lastBackground = background;
+    }
+    output.append(cell.glyph, 2);
+}
+
+void TerminalRenderer::render(const GameState& state)
+{
+    TerminalCell next[LudoBoard::BOARD_SIZE][LudoBoard::BOARD_SIZE];
+    buildFrame(state, next);
+
+    output.clear();
+    if (!frameValid) {
+        output += "\x1b[?25l\x1b[2J";
+    }
+    lastBackground = -1;
+
+    for (int row = 0; row < LudoBoard::BOARD_SIZE; ++row) {
+        int cursorColumn = -1;
+        for (int column = 0; column < LudoBoard::BOARD_SIZE; ++column) {
+            if (frameValid && next[row][column] == frame[row][column]) continue;
+
+            // Runs of changed cells share one cursor move
+            if (column != cursorColumn) {
+                moveCursor(row, column);
+            }
+            emitCell(next[row][column]);
+            frame[row][column] = next[row][column];
+            cursorColumn = column + 1;
+        }
+    }
+
+    char nextStatus[STATUS_LENGTH];
+    if (state.numPlayers - state.finishedPlayers - state.eliminatedPlayers <= 1) {
+        if (state.finishedPlayers > 0) {
+            snprintf(nextStatus, sizeof(nextStatus), "Game over | Winner: Player %d | Turn %d",
+                     state.finishingOrder[0] + 1, state.turn);
+        } else {
+            snprintf(nextStatus, sizeof(nextStatus), "Game over | No winner | Turn %d", state.turn);
+        }
+    } else {
+        snprintf(nextStatus, sizeof(nextStatus), "Player %d | Dice: %d | Turn %d",
+                 state.currentPlayer + 1, state.diceValue, state.turn);
+    }
+
+    if (!frameValid || strcmp(nextStatus, status) != 0) {
+        moveCursor(LudoBoard::BOARD_SIZE, 0);
+        output += "\x1b[0m";
+        output += nextStatus;
+        output += "\x1b[K";
+        strcpy(status, nextStatus);
+        lastBackground = -1;
+    }
+
+    if (!output.empty() && lastBackground != -1) {
+        output += "\x1b[0m";
+    }
+
+    frameValid = true;
+    flush();
+}
+
+void TerminalRenderer::flush()
+{
+    size_t offset = 0;
+    while (offset < output.size()) {
+        ssize_t written = write(fd, output.data() + offset, output.size() - offset);
+        if (written <= 0) {
+            break;
+        }
+        offset += written;
+    }
+    totalBytes += offset;
+    output.clear();
+}
+
+void watchGame(const BatchConfig& config)
+{
+    unique_ptr<RulesEngine> engine = makeRulesEngine(config.rules, static_cast<uint32_t>(config.seed));
+    unique_ptr<StatePublisher> publisher;
+    if (!config.publishName.empty()) {
+        publisher.reset(new StatePublisher(config.publishName));
+    }
+    size_t bytes = 0;
+
+    {
+        TerminalRenderer renderer;
+        renderer.render(engine->state());
+
+        while (engine->state().turn < config.maxTurns && engine->playRandomTurn()) {
+            if (publisher) {
+                publisher->publish(engine->state(), false);
+            }
+            renderer.render(engine->state());
+            this_thread::sleep_for(chrono::milliseconds(config.frameDelayMs));
+        }
+        if (publisher) {
+            publisher->publish(engine->state(), true);
+        }
+        bytes = renderer.bytesWritten();
+    }
+
+    cout << engine->state().turn << " moves, " << bytes << " bytes written" << endl;
+}
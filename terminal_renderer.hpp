@@ -0,0 +1,57 @@
+#ifndef TERMINAL_RENDERER_HPP
+#define TERMINAL_RENDERER_HPP
+
+#pragma once
+
+#include <unistd.h>
+#include <cstring>
+#include <string>
+#include "ludo_engine.hpp"
+#include "batch_simulator.hpp"
+#include "state_publisher.hpp"
+
+using namespace std;
+
+// ANSI renderer for headless observation. Each board cell is two characters wide
+// and laid out like drawBoard. Only cells whose colour or glyph changed since the
+// previous frame are written, so watching a game over SSH costs a few bytes per move.
+class TerminalRenderer {
+public:
+    explicit TerminalRenderer(int fd = STDOUT_FILENO);
+    ~TerminalRenderer();
+
+    void render(const GameState& state);
+    void invalidate() { frameValid = false; }
+    size_t bytesWritten() const { return totalBytes; }
+
+private:
+    struct TerminalCell {
+        uint8_t background;     // CellKind
+        char glyph[2];
+
+        bool operator==(const TerminalCell& other) const {
+            return background == other.background && glyph[0] == other.glyph[0] && glyph[1] == other.glyph[1];
+        }
+    };
+
+    static const int STATUS_LENGTH = 64;
+
+    int fd;
+    TerminalCell frame[LudoBoard::BOARD_SIZE][LudoBoard::BOARD_SIZE];
+    char status[STATUS_LENGTH];
+    bool frameValid;
+    int lastBackground;
+    size_t totalBytes;
+    string output;
+
+    void buildFrame(const GameState& state, TerminalCell next[LudoBoard::BOARD_SIZE][LudoBoard::BOARD_SIZE]);
+    void moveCursor(int row, int column);
+    void emitCell(const TerminalCell& cell);
+    void flush();
+};
+
+// Plays one seeded random game and draws every move in the terminal, publishing
+// each move to shared memory when config.publishName is set
+void watchGame(const BatchConfig& config);
+
+#endif // TERMINAL_RENDERER_HPP
@@ -0,0 +1,91 @@
+#include "timer_wheel.hpp"
+
+TimerWheel::TimerWheel(uint64_t startTick)
+    : currentTick(startTick),
+      scheduled(0)
+{
+    for (int level = 0; level < LEVELS; ++level) {
+        for (int slot = 0; slot < SLOTS; ++slot) {
+            slots[level][slot].next = &slots[level][slot];
+            slots[level][slot].prev = &slots[level][slot];
+        }
+    }
+}
+
+void TimerWheel::insert(TimerNode* node)
+{
+    uint64_t delta = node->deadline - currentTick;
+
+    // Pick the finest level whose span still covers the deadline
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    int slot = (node->deadline >> (SLOT_BITS * level)) & (SLOTS - 1);
+
+    TimerNode* head = &slots[level][slot];
+    node->next = head;
+    node->prev = head->prev;
+    head->prev->next = node;
+    head->prev = node;
+}
+
+void TimerWheel::schedule(TimerNode* node, uint64_t delay)
+{
+    if (node->isScheduled()) {
+        cancel(node);
+    }
+
+    node->deadline = currentTick + (delay == 0 ? 1 : (delay > MAX_DELAY ? MAX_DELAY : delay));
+    insert(node);
+    scheduled++;
+}
+
+void TimerWheel::cancel(TimerNode* node)
+{
+    if (!node->isScheduled()) {
+        return;
+    }
+
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->next = nullptr;
+    node->prev = nullptr;
+    scheduled--;
+}
+
+void TimerWheel::cascade(int level, int slot)
+{
+    TimerNode* head = &slots[level][slot];
+    TimerNode* node = head->next;
+    head->next = head;
+    head->prev = head;
+
+    while (node != head) {
+        TimerNode* next = node->next;
+        insert(node);
+        node = next;
+    }
+}
+
+void TimerWheel::advance(uint64_t tick)
+{
+    while (currentTick < tick) {
+        currentTick++;
+
+        // Refill finer wheels from coarser ones when their index wraps, top level first
+        for (int level = LEVELS - 1; level > 0; --level) {
+            if ((currentTick & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) == 0) {
+                cascade(level, (currentTick >> (SLOT_BITS * level)) & (SLOTS - 1));
+            }
+        }
+
+        TimerNode* head = &slots[0][currentTick & (SLOTS - 1)];
+        while (head->next != head) {
+            TimerNode* node = head->next;
+            cancel(node);
+            // Callbacks may reschedule the node or arm other timers
+            node->callback(node, node->context);
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#pragma once
+
+#include <cstdint>
+
+using namespace std;
+
+// Intrusive timer. Owners embed one per deadline they track (per game, per player)
+// so scheduling never allocates.
+struct TimerNode {
+    TimerNode* next = nullptr;
+    TimerNode* prev = nullptr;
+    uint64_t deadline = 0;
+    void (*callback)(TimerNode* node, void* context) = nullptr;
+    void* context = nullptr;
+
+    bool isScheduled() const { return prev != nullptr; }
+};
+
+// Hierarchical timing wheel: LEVELS wheels of SLOTS buckets, each level SLOTS times
+// coarser than the one below. Schedule and cancel are O(1); advancing costs O(1) per
+// tick plus the timers that fire or cascade. Time is in ticks, chosen by the owner.
+class TimerWheel {
+public:
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int LEVELS = 4;
+    static const uint64_t MAX_DELAY = (uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+
+    explicit TimerWheel(uint64_t startTick = 0);
+
+    // Fires node->callback at tick now() + delay (at least one tick from now)
+    void schedule(TimerNode* node, uint64_t delay);
+    void cancel(TimerNode* node);
+
+    // Runs every tick up to and including tick, firing expired timers in deadline order
+    void advance(uint64_t tick);
+    uint64_t now() const { return currentTick; }
+    int scheduledCount() const { return scheduled; }
+
+private:
+    TimerNode slots[LEVELS][SLOTS];
+    uint64_t currentTick;
+    int scheduled;
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    void insert(TimerNode* node);
+    void cascade(int level, int slot);
+};
+
+#endif // TIMER_WHEEL_HPP